@@ -0,0 +1,91 @@
+#include "CollectionStats.h"
+
+namespace {
+
+// Активна проба поточного потоку
+thread_local ProbeScope* t_currentScope = nullptr;
+
+} // namespace
+
+// ========================================
+// CollectionStats
+// ========================================
+
+const char* CollectionStats::sourceToString(ProbeSource source)
+{
+    switch (source) {
+    case ProbeSource::SystemApi: return "api";
+    case ProbeSource::Procfs: return "procfs";
+    case ProbeSource::Sysfs: return "sysfs";
+    case ProbeSource::Subprocess: return "subprocess";
+    case ProbeSource::Cache: return "cache";
+    default: return "unknown";
+    }
+}
+
+const char* CollectionStats::outcomeToString(ProbeOutcome outcome)
+{
+    switch (outcome) {
+    case ProbeOutcome::Ok: return "ok";
+    case ProbeOutcome::Missing: return "missing";
+    case ProbeOutcome::Failed: return "failed";
+    case ProbeOutcome::Timeout: return "timeout";
+    default: return "unknown";
+    }
+}
+
+// ========================================
+// ProbeScope
+// ========================================
+
+ProbeScope::ProbeScope(CollectionStats* stats, const char* probe, ProbeSource source)
+    : m_stats(stats),
+      m_parent(nullptr),
+      m_trace("probe", probe)
+{
+    if (!m_stats)
+        return;
+
+    m_probe.probe = probe;
+    m_probe.source = source;
+    m_parent = t_currentScope;
+    t_currentScope = this;
+    m_start = std::chrono::steady_clock::now();
+}
+
+ProbeScope::~ProbeScope()
+{
+    if (!m_stats)
+        return;
+
+    m_probe.duration_us = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - m_start).count());
+
+    // Підпроцес визначає вартість проби; якщо все прийшло з кешу - це теж видно
+    if (m_probe.subprocesses > 0)
+        m_probe.source = ProbeSource::Subprocess;
+    else if (m_probe.cache_hits > 0)
+        m_probe.source = ProbeSource::Cache;
+
+    t_currentScope = m_parent;
+    m_stats->total_subprocesses += m_probe.subprocesses;
+    m_stats->probes.push_back(m_probe);
+}
+
+void ProbeScope::noteSubprocess()
+{
+    if (t_currentScope)
+        ++t_currentScope->m_probe.subprocesses;
+}
+
+void ProbeScope::noteCacheHit()
+{
+    if (t_currentScope)
+        ++t_currentScope->m_probe.cache_hits;
+}
+
+void ProbeScope::noteOutcome(ProbeOutcome outcome)
+{
+    if (t_currentScope && outcome > t_currentScope->m_probe.outcome)
+        t_currentScope->m_probe.outcome = outcome;
+}
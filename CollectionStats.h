@@ -0,0 +1,84 @@
+#ifndef COLLECTIONSTATS_H
+#define COLLECTIONSTATS_H
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "Tracer.h"
+
+// ========================================
+// Звідки проба взяла дані
+// ========================================
+enum class ProbeSource : uint8_t {
+    Unknown = 0,
+    SystemApi = 1,     // sysinfo, statfs, CPUID, QSysInfo, реєстр, DXGI/WMI
+    Procfs = 2,        // /proc
+    Sysfs = 3,         // /sys
+    Subprocess = 4,    // lspci, nvidia-smi, lsblk
+    Cache = 5          // Результат з кешу без звернення до джерела
+};
+
+// ========================================
+// Результат проби
+// ========================================
+enum class ProbeOutcome : uint8_t {
+    Ok = 0,
+    Missing = 1,       // Джерела немає (файл відсутній, утиліта не встановлена)
+    Failed = 2,        // Джерело є, але дані не розібрано
+    Timeout = 3        // Підпроцес не встиг до дедлайну
+};
+
+// ========================================
+// Статистика однієї проби
+// ========================================
+struct ProbeStats {
+    std::string probe;                         // "cpu", "gpu", "disks" ...
+    uint64_t duration_us = 0;
+    ProbeSource source = ProbeSource::Unknown;
+    ProbeOutcome outcome = ProbeOutcome::Ok;
+    uint32_t subprocesses = 0;                 // Запущено підпроцесів
+    uint32_t cache_hits = 0;                   // Відповідей з кешу замість джерела
+};
+
+// ========================================
+// Статистика всього getDeviceInfo()
+// ========================================
+struct CollectionStats {
+    std::vector<ProbeStats> probes;            // У порядку виконання
+    uint64_t total_duration_us = 0;
+    uint32_t total_subprocesses = 0;
+
+    static const char* sourceToString(ProbeSource source);
+    static const char* outcomeToString(ProbeOutcome outcome);
+};
+
+// ========================================
+// ProbeScope - вимірює пробу та збирає події з глибших викликів
+// ========================================
+//
+// Поки scope активний на потоці, допоміжні функції (запуск підпроцесу,
+// кеш) повідомляють про себе через статичні note*(). Без CollectionStats
+// (stats == nullptr) scope лише пише span у Tracer, якщо той увімкнено.
+class ProbeScope
+{
+public:
+    ProbeScope(CollectionStats* stats, const char* probe, ProbeSource source);
+    ~ProbeScope();
+
+    ProbeScope(const ProbeScope&) = delete;
+    ProbeScope& operator=(const ProbeScope&) = delete;
+
+    static void noteSubprocess();
+    static void noteCacheHit();
+    static void noteOutcome(ProbeOutcome outcome);   // Залишається найгірший результат
+
+private:
+    CollectionStats* m_stats;
+    ProbeScope* m_parent;
+    ProbeStats m_probe;
+    std::chrono::steady_clock::time_point m_start;
+    TraceSpan m_trace;
+};
+
+#endif // COLLECTIONSTATS_H
@@ -0,0 +1,1915 @@
+#include "DeviceCollector.h"
+#include "ProcessRunner.h"
+#include "Tracer.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string_view>
+#include <thread>
+
+#ifdef __linux__
+#include <cerrno>
+#include <climits>
+#include <dirent.h>
+#include <fcntl.h>
+#include <fnmatch.h>
+#include <fstream>
+#include <sched.h>
+#include <sys/stat.h>
+#include <sys/statvfs.h>
+#include <sys/sysinfo.h>
+#include <sys/utsname.h>
+#include <unistd.h>
+#endif
+
+#if defined(__linux__) && (defined(__x86_64__) || defined(__i386__))
+#include <cpuid.h>
+#define HWINFO_HAVE_CPUID 1
+#endif
+
+namespace {
+
+// Скільки живе вивід джерела в SourceCache
+const std::chrono::milliseconds kLspciTtl = std::chrono::minutes(5);      // Набір PCI-пристроїв
+const std::chrono::milliseconds kNvidiaSmiTtl = std::chrono::seconds(1);  // VRAM змінюється, але не за один збір
+const std::chrono::milliseconds kLsblkTtl = std::chrono::seconds(30);     // Підхоплює hotplug дисків
+
+// lspci та типи дисків, поки їх інвалідують uevent-и: повторно лише після hotplug
+const std::chrono::milliseconds kHotplugTrackedTtl = std::chrono::hours(24);
+
+// Перевірка скасування збору, що виконується на цьому потоці (getDeviceInfoAsync)
+thread_local const std::function<bool()>* t_cancelCheck = nullptr;
+
+bool collectionCanceled()
+{
+    return t_cancelCheck && (*t_cancelCheck)();
+}
+
+// Встановлює перевірку скасування на час collect()
+class CancelCheckGuard
+{
+public:
+    explicit CancelCheckGuard(const std::function<bool()>& isCanceled)
+        : m_previous(t_cancelCheck)
+    {
+        if (isCanceled) t_cancelCheck = &isCanceled;
+    }
+    ~CancelCheckGuard() { t_cancelCheck = m_previous; }
+
+    CancelCheckGuard(const CancelCheckGuard&) = delete;
+    CancelCheckGuard& operator=(const CancelCheckGuard&) = delete;
+
+private:
+    const std::function<bool()>* m_previous;
+};
+
+// Секція -> секції, без яких її не заповнити
+struct FieldDependency {
+    DeviceField field;
+    DeviceField dependsOn;
+};
+
+const FieldDependency kFieldDependencies[] = {
+    { DeviceField::Cgroup, DeviceField::CPU | DeviceField::RAM },
+    { DeviceField::GPU, DeviceField::Sensors },
+    { DeviceField::Disks, DeviceField::DiskSpace | DeviceField::DiskIO },
+};
+
+// Рядок опціонального поля переписується на місці, якщо вже є
+void assignOptional(std::optional<std::string>& field, std::string_view value)
+{
+    if (field.has_value())
+        field->assign(value.data(), value.size());
+    else
+        field.emplace(value);
+}
+
+const char* diskTypeName(DiskType type)
+{
+    switch (type) {
+    case DiskType::SSD: return "SSD";
+    case DiskType::HDD: return "HDD";
+    case DiskType::External: return "External";
+    case DiskType::Removable: return "Removable";
+    default: return "Unknown";
+    }
+}
+
+} // namespace
+
+CollectOptions CollectOptions::resolved() const
+{
+    CollectOptions result = *this;
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (const FieldDependency& dependency : kFieldDependencies) {
+            uint32_t required = static_cast<uint32_t>(dependency.dependsOn);
+            if (result.has(dependency.field) && (result.fields & required) != required) {
+                result.fields |= required;
+                changed = true;
+            }
+        }
+    }
+    return result;
+}
+
+// ========================================
+// Конструктор та деструктор
+// ========================================
+
+DeviceCollector::DeviceCollector()
+    : m_sensors(std::make_unique<SensorCollector>())
+{
+#ifdef __linux__
+    // Без сокета (seccomp, старе ядро) кеш працює на звичайних TTL
+    m_uevents = std::make_unique<UeventMonitor>([this](const Uevent& event) { applyUevent(event); });
+#endif
+}
+
+DeviceCollector::~DeviceCollector() = default;
+
+DiskType DeviceCollector::diskTypeFromString(const std::string& type)
+{
+    std::string lower = type;
+    std::transform(lower.begin(), lower.end(), lower.begin(),
+                   [](unsigned char c) { return static_cast<char>(tolower(c)); });
+
+    if (lower == "ssd") return DiskType::SSD;
+    if (lower == "hdd") return DiskType::HDD;
+    if (lower == "external") return DiskType::External;
+    if (lower == "removable") return DiskType::Removable;
+    return DiskType::Unknown;
+}
+
+// ========================================
+// Запуск утиліт
+// ========================================
+
+bool DeviceCollector::runCommand(const std::string& program, const std::vector<std::string>& arguments,
+                                 int timeoutMs, std::string& output)
+{
+    TraceSpan span("subprocess", "exec");
+    if (span.isActive()) span.setDetail(program.c_str());
+
+    static const std::function<bool()> kNotCanceled;
+    ProcessResult result = ProcessRunner::instance().run(program, arguments,
+        std::chrono::milliseconds(timeoutMs), output, t_cancelCheck ? *t_cancelCheck : kNotCanceled);
+
+    // Утиліта не встановлена - підпроцес не запускався, і це не таймаут
+    if (result.status == ProcessStatus::NotFound) {
+        ProbeScope::noteOutcome(ProbeOutcome::Missing);
+        return false;
+    }
+    if (result.status == ProcessStatus::Failed) {
+        ProbeScope::noteOutcome(ProbeOutcome::Failed);
+        return false;
+    }
+
+    ProbeScope::noteSubprocess();
+    if (result.status == ProcessStatus::Timeout) {
+        ProbeScope::noteOutcome(ProbeOutcome::Timeout);
+        return false;
+    }
+    return result.status != ProcessStatus::Canceled;
+}
+
+bool DeviceCollector::runCachedCommand(const std::string& program, const std::vector<std::string>& arguments,
+                                       int timeoutMs, std::chrono::milliseconds ttl, std::string& output) const
+{
+    std::string key = "cmd:" + program;
+    for (const std::string& argument : arguments) {
+        key += ' ';
+        key += argument;
+    }
+
+    SourceCache::Lookup lookup = m_cache.get(key, ttl, [&](std::string& fetched) {
+        return runCommand(program, arguments, timeoutMs, fetched);
+    }, output, collectionCanceled);
+
+    if (lookup == SourceCache::Lookup::Failed)
+        return false;
+    if (lookup != SourceCache::Lookup::Fetched)
+        ProbeScope::noteCacheHit();
+    return true;
+}
+
+// ========================================
+// Кеш та hotplug
+// ========================================
+
+SourceCache& DeviceCollector::cache() const
+{
+    return m_cache;
+}
+
+void DeviceCollector::invalidateCache(const std::string& prefix)
+{
+    m_cache.invalidatePrefix(prefix);
+
+#ifdef __linux__
+    // Повне скидання перебудовує і перелік томів, навіть без події mountinfo
+    if (prefix.empty()) {
+        {
+            std::lock_guard<std::mutex> lock(m_volumesMutex);
+            m_volumes.valid = false;
+        }
+        {
+            std::lock_guard<std::mutex> lock(m_energyMutex);
+            m_powerZonesScanned = false;
+        }
+        m_sensorsStale.store(true);
+    }
+#endif
+}
+
+bool DeviceCollector::injectUevent(const std::string& message)
+{
+#ifdef __linux__
+    if (!m_uevents)
+        return false;
+    std::lock_guard<std::mutex> lock(m_ueventMutex);
+    return m_uevents->inject(message.data(), message.size());
+#else
+    (void)message;
+    return false;
+#endif
+}
+
+bool DeviceCollector::volumeTypesStale() const
+{
+    return m_volumeTypesStale.load();
+}
+
+bool DeviceCollector::sensorsStale() const
+{
+    return m_sensorsStale.load();
+}
+
+void DeviceCollector::refreshSensors() const
+{
+#ifdef __linux__
+    pumpUevents();
+#endif
+    // Читання, що йдуть паралельно, бачать старий або новий перелік цілим
+    if (m_sensorsStale.exchange(false))
+        m_sensors->discover();
+}
+
+std::vector<SensorReading> DeviceCollector::sensors() const
+{
+    refreshSensors();
+    return m_sensors->read();
+}
+
+std::optional<CgroupLimits> DeviceCollector::cgroupLimits() const
+{
+    CgroupLimits limits;
+    if (!cgroupLimitsInto(limits))
+        return std::nullopt;
+    return limits;
+}
+
+std::vector<DiskIOStats> DeviceCollector::diskIOStats() const
+{
+    std::vector<DiskIOStats> result;
+    diskIOStatsInto(result);
+    return result;
+}
+
+std::vector<NetInterfaceInfo> DeviceCollector::networkInterfaces() const
+{
+    std::vector<NetInterfaceInfo> result;
+    networkInterfacesInto(result);
+    return result;
+}
+
+std::vector<PowerDomainInfo> DeviceCollector::powerDomains() const
+{
+    std::vector<PowerDomainInfo> result;
+    powerDomainsInto(result);
+    return result;
+}
+
+const DeviceCollector::Identity& DeviceCollector::identity() const
+{
+    std::call_once(m_identityOnce, [this] {
+        m_identity.os = osName();
+        m_identity.kernel = kernelVersion();
+        m_identity.arch = architecture();
+        m_identity.cpuModel = cpuModel();
+        m_identity.cpuFrequencyMHz = cpuFrequencyMHz();
+    });
+    return m_identity;
+}
+
+uint32_t DeviceCollector::effectiveCPUCores(uint32_t hostCores, const std::optional<CgroupLimits>& limits)
+{
+    uint32_t cores = hostCores;
+    if (!limits.has_value()) return cores;
+
+    if (limits->cpuset_cpus.has_value() && limits->cpuset_cpus.value() > 0) {
+        cores = std::min(cores, limits->cpuset_cpus.value());
+    }
+    if (limits->cpu_quota_cores.has_value()) {
+        // Квота 1.5 ядра = 2 потоки, які ще не будуть постійно тротлитися
+        uint32_t quotaCores = static_cast<uint32_t>(std::ceil(limits->cpu_quota_cores.value()));
+        cores = std::min(cores, std::max<uint32_t>(1, quotaCores));
+    }
+    return cores;
+}
+
+uint64_t DeviceCollector::effectiveRAM(uint64_t hostBytes, const std::optional<CgroupLimits>& limits)
+{
+    uint64_t bytes = hostBytes;
+    if (!limits.has_value()) return bytes;
+
+    if (limits->memory_max_mb.has_value()) {
+        bytes = std::min<uint64_t>(bytes, limits->memory_max_mb.value() * 1024 * 1024);
+    }
+    if (limits->memory_high_mb.has_value()) {
+        bytes = std::min<uint64_t>(bytes, limits->memory_high_mb.value() * 1024 * 1024);
+    }
+    return bytes;
+}
+
+#ifdef __linux__
+// ========================================
+// Допоміжні функції - Linux
+// ========================================
+
+namespace {
+
+// Читає файл повністю у buffer, перевикористовуючи його ємність між викликами
+bool readFileInto(const char* path, std::string& buffer)
+{
+    TraceSpan span("file", "read", path);
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+        return false;
+
+    if (buffer.capacity() < 4096)
+        buffer.reserve(4096);
+    buffer.resize(buffer.capacity());
+
+    size_t total = 0;
+    while (true) {
+        if (total == buffer.size())
+            buffer.resize(buffer.size() * 2);
+        ssize_t n = read(fd, &buffer[total], buffer.size() - total);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) break;
+        total += static_cast<size_t>(n);
+    }
+    close(fd);
+
+    buffer.resize(total);
+    return true;
+}
+
+// Невелике ціле з sysfs без алокацій; false для "-1", помилки або порожнього файлу
+bool readSysfsUInt(const char* path, uint32_t& value)
+{
+    TraceSpan span("file", "read", path);
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+        return false;
+
+    char buf[32];
+    ssize_t n = read(fd, buf, sizeof(buf) - 1);
+    close(fd);
+    if (n <= 0)
+        return false;
+    buf[n] = '\0';
+
+    char* end = nullptr;
+    long long parsed = strtoll(buf, &end, 10);
+    if (end == buf || parsed < 0)
+        return false;
+    value = static_cast<uint32_t>(parsed);
+    return true;
+}
+
+bool readSysfsUInt64(const char* path, uint64_t& value)
+{
+    TraceSpan span("file", "read", path);
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+        return false;   // energy_uj з ядра 5.10 читається лише root (CVE-2020-8694)
+
+    char buf[32];
+    ssize_t n = read(fd, buf, sizeof(buf) - 1);
+    close(fd);
+    if (n <= 0)
+        return false;
+    buf[n] = '\0';
+
+    char* end = nullptr;
+    value = strtoull(buf, &end, 10);
+    return end != buf;
+}
+
+// Невеликий файл /proc або /sys у buf (з '\0'); -1, якщо файл недоступний
+ssize_t readSmallFile(const char* path, char* buf, size_t size)
+{
+    TraceSpan span("file", "read", path);
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+        return -1;
+
+    size_t total = 0;
+    while (total + 1 < size) {
+        ssize_t n = read(fd, buf + total, size - 1 - total);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) break;
+        total += static_cast<size_t>(n);
+    }
+    close(fd);
+
+    buf[total] = '\0';
+    return static_cast<ssize_t>(total);
+}
+
+const char* const kCgroupRoot = "/sys/fs/cgroup";
+
+// Перший рядок файлу без кінцевих пробілів; false (і порожній buf), якщо файл недоступний
+bool readFirstLine(const char* path, char* buf, size_t size)
+{
+    if (readSmallFile(path, buf, size) < 0) {
+        buf[0] = '\0';
+        return false;
+    }
+    buf[strcspn(buf, "\n")] = '\0';
+    size_t length = strlen(buf);
+    while (length > 0 && isspace(static_cast<unsigned char>(buf[length - 1])))
+        buf[--length] = '\0';
+    return true;
+}
+
+// memory.max / memory.high: "max" або відсутній файл = немає ліміту
+std::optional<uint64_t> readCgroupBytes(const char* path)
+{
+    char value[32];
+    if (!readFirstLine(path, value, sizeof(value)) || value[0] == '\0' || strcmp(value, "max") == 0)
+        return std::nullopt;
+
+    unsigned long long bytes = 0;
+    if (sscanf(value, "%llu", &bytes) != 1)
+        return std::nullopt;
+    return bytes;
+}
+
+// Кількість CPU у списку формату "0-3,8,10-11"
+uint32_t countCpuList(const char* list)
+{
+    uint32_t count = 0;
+    const char* p = list;
+    while (*p) {
+        char* end = nullptr;
+        unsigned long first = strtoul(p, &end, 10);
+        if (end == p) break;
+        unsigned long last = first;
+        p = end;
+        if (*p == '-') {
+            ++p;
+            last = strtoul(p, &end, 10);
+            if (end == p) break;
+            p = end;
+        }
+        if (last >= first) count += static_cast<uint32_t>(last - first + 1);
+        if (*p == ',') ++p;
+    }
+    return count;
+}
+
+// Каталог cgroup процесу з рядка "0::/path" у /proc/self/cgroup
+void cgroupPathOfSelf(char* path, size_t size)
+{
+    char content[4096];
+    if (readSmallFile("/proc/self/cgroup", content, sizeof(content)) > 0) {
+        for (const char* line = content; *line;) {
+            const char* lineEnd = strchr(line, '\n');
+            size_t lineLength = lineEnd ? static_cast<size_t>(lineEnd - line) : strlen(line);
+            if (lineLength >= 3 && strncmp(line, "0::", 3) == 0) {
+                int length = snprintf(path, size, "%s%.*s", kCgroupRoot, static_cast<int>(lineLength - 3), line + 3);
+                if (length > 0 && static_cast<size_t>(length) < size) {
+                    while (length > 1 && path[length - 1] == '/')
+                        path[--length] = '\0';
+
+                    struct stat st;
+                    if (stat(path, &st) == 0 && S_ISDIR(st.st_mode))
+                        return;
+                }
+                break;
+            }
+            if (!lineEnd) break;
+            line = lineEnd + 1;
+        }
+    }
+    // Без cgroup namespace шлях хоста у контейнері не існує -
+    // змонтований /sys/fs/cgroup і є cgroup контейнера
+    snprintf(path, size, "%s", kCgroupRoot);
+}
+
+// Рядки формату "some avg10=0.12 avg60=0.05 avg300=0.01 total=123456"
+std::optional<PressureInfo> readPressureFile(const char* path)
+{
+    char content[512];
+    if (readSmallFile(path, content, sizeof(content)) < 0)
+        return std::nullopt;
+
+    PressureInfo info;
+    for (char* line = content; *line;) {
+        char* lineEnd = strchr(line, '\n');
+        if (lineEnd) *lineEnd = '\0';
+
+        char kind[8];
+        PressureStats stats;
+        unsigned long long total = 0;
+        if (sscanf(line, "%7s avg10=%lf avg60=%lf avg300=%lf total=%llu",
+                   kind, &stats.avg10, &stats.avg60, &stats.avg300, &total) == 5) {
+            stats.total_us = total;
+            if (strcmp(kind, "some") == 0) info.some = stats;
+            else if (strcmp(kind, "full") == 0) info.full = stats;
+        }
+
+        if (!lineEnd) break;
+        line = lineEnd + 1;
+    }
+
+    if (!info.some.has_value() && !info.full.has_value())
+        return std::nullopt;
+    return info;
+}
+
+std::string rotationalDiskType(const std::string& deviceName)
+{
+    // Якщо NVMe — одразу SSD
+    if (deviceName.rfind("nvme", 0) == 0)
+        return "SSD";
+
+    std::string path = "/sys/block/" + deviceName + "/queue/rotational";
+    TraceSpan span("file", "read", path.c_str());
+    std::ifstream file(path);
+    if (!file.is_open())
+        return "Unknown";
+
+    int val = 1;
+    file >> val;
+    return (val == 0) ? "SSD" : "HDD";
+}
+
+// Цілий диск за ім'ям розділу, коли sysfs недоступний: nvme0n1p2, mmcblk0p1,
+// loop0p1 -> nvme0n1, mmcblk0, loop0 (цифра перед "p<N>"); sda1, vdb2 -> sda, vdb.
+// Імена цілих дисків (nvme0n1, mmcblk0, dm-0, md0) лишаються як є
+std::string parentDiskName(const std::string& device)
+{
+    std::string name = device.compare(0, 5, "/dev/") == 0 ? device.substr(5) : device;
+    size_t digits = name.size();
+    while (digits > 0 && isdigit(static_cast<unsigned char>(name[digits - 1]))) --digits;
+    if (digits == name.size() || digits == 0)
+        return name;
+
+    if (name[digits - 1] == 'p' && digits >= 2 && isdigit(static_cast<unsigned char>(name[digits - 2])))
+        return name.substr(0, digits - 1);
+
+    static const char* const kLetterDisks[] = { "sd", "hd", "vd", "xvd" };
+    for (const char* prefix : kLetterDisks) {
+        if (name.compare(0, strlen(prefix), prefix) == 0)
+            return name.substr(0, digits);
+    }
+    return name;
+}
+
+std::string diskTypeKeyOf(const std::string& disk)
+{
+    return "disktype:" + disk;
+}
+
+// PCI_CLASS=30000: базовий клас 0x03 - VGA, 3D та інші дисплейні контролери
+bool isDisplayController(const std::string& pciClass)
+{
+    return !pciClass.empty() && (std::strtoul(pciClass.c_str(), nullptr, 16) >> 16) == 0x03;
+}
+
+std::string_view trimView(std::string_view text)
+{
+    while (!text.empty() && isspace(static_cast<unsigned char>(text.front()))) text.remove_prefix(1);
+    while (!text.empty() && isspace(static_cast<unsigned char>(text.back()))) text.remove_suffix(1);
+    return text;
+}
+
+bool containsNoCase(std::string_view text, std::string_view needle)
+{
+    auto it = std::search(text.begin(), text.end(), needle.begin(), needle.end(), [](char a, char b) {
+        return tolower(static_cast<unsigned char>(a)) == tolower(static_cast<unsigned char>(b));
+    });
+    return it != text.end();
+}
+
+bool equalsNoCase(std::string_view text, std::string_view other)
+{
+    return text.size() == other.size() && containsNoCase(text, other);
+}
+
+// Наступний рядок text, починаючи з pos; false - текст закінчився
+bool nextLine(std::string_view text, size_t& pos, std::string_view& line)
+{
+    if (pos >= text.size())
+        return false;
+    size_t end = text.find('\n', pos);
+    if (end == std::string_view::npos) end = text.size();
+    line = text.substr(pos, end - pos);
+    pos = end + 1;
+    return true;
+}
+
+// Імена записів каталогу за glob-шаблоном у порядку сортування (як QDir::entryList)
+std::vector<std::string> listDirectory(const char* path, const char* pattern)
+{
+    std::vector<std::string> names;
+    DIR* dir = opendir(path);
+    if (dir == nullptr)
+        return names;
+    while (struct dirent* entry = readdir(dir)) {
+        if (fnmatch(pattern, entry->d_name, 0) == 0)
+            names.emplace_back(entry->d_name);
+    }
+    closedir(dir);
+    std::sort(names.begin(), names.end());
+    return names;
+}
+
+// Поля /proc/self/mountinfo екранують пробіли та спецсимволи як \040
+std::string unescapeMountField(std::string_view field)
+{
+    std::string result;
+    result.reserve(field.size());
+    for (size_t i = 0; i < field.size(); ++i) {
+        if (field[i] == '\\' && i + 3 < field.size() &&
+            field[i + 1] >= '0' && field[i + 1] <= '3' &&
+            field[i + 2] >= '0' && field[i + 2] <= '7' &&
+            field[i + 3] >= '0' && field[i + 3] <= '7') {
+            result += static_cast<char>((field[i + 1] - '0') * 64 + (field[i + 2] - '0') * 8 + (field[i + 3] - '0'));
+            i += 3;
+        }
+        else {
+            result += field[i];
+        }
+    }
+    return result;
+}
+
+// Файлові системи без блочного сховища - їх не показує і QStorageInfo::mountedVolumes()
+bool isPseudoFilesystem(std::string_view type)
+{
+    static const char* const kPseudo[] = {
+        "autofs", "binfmt_misc", "bpf", "cgroup", "cgroup2", "configfs", "debugfs",
+        "devpts", "efivarfs", "fusectl", "hugetlbfs", "mqueue", "nsfs", "proc",
+        "pstore", "rpc_pipefs", "securityfs", "selinuxfs", "sysfs", "tracefs"
+    };
+    for (const char* pseudo : kPseudo) {
+        if (type == pseudo) return true;
+    }
+    return false;
+}
+
+// Оновлює лише розміри відомих томів; false - том зник, перелік треба перебудувати
+bool refreshVolumeUsage(std::vector<VolumeInfo>& volumes)
+{
+    for (VolumeInfo& volume : volumes) {
+        struct statvfs fs;
+        if (statvfs(volume.mount_point.c_str(), &fs) != 0)
+            return false;
+
+        // Ті самі формули, що й у QStorageInfo::bytesTotal()/bytesFree()
+        volume.total_bytes = static_cast<uint64_t>(fs.f_blocks) * fs.f_frsize;
+        volume.free_bytes = static_cast<uint64_t>(fs.f_bfree) * fs.f_frsize;
+        volume.used_bytes = volume.total_bytes - volume.free_bytes;
+        volume.usage_percent = volume.total_bytes > 0 ? (volume.used_bytes * 100.0) / volume.total_bytes : 0.0;
+    }
+    return true;
+}
+
+#ifdef HWINFO_HAVE_CPUID
+// Рядок бренду з листів CPUID 0x80000002-0x80000004 (48 байтів, Intel вирівнює пробілами зліва)
+bool cpuidBrandString(std::string& brand)
+{
+    unsigned int eax = 0, ebx = 0, ecx = 0, edx = 0;
+    if (__get_cpuid_max(0x80000000u, nullptr) < 0x80000004u)
+        return false;
+
+    char text[49] = {};
+    for (unsigned int i = 0; i < 3; ++i) {
+        if (!__get_cpuid(0x80000002u + i, &eax, &ebx, &ecx, &edx))
+            return false;
+        memcpy(text + i * 16, &eax, 4);
+        memcpy(text + i * 16 + 4, &ebx, 4);
+        memcpy(text + i * 16 + 8, &ecx, 4);
+        memcpy(text + i * 16 + 12, &edx, 4);
+    }
+
+    std::string_view trimmed = trimView(std::string_view(text, strnlen(text, 48)));
+    if (trimmed.empty())
+        return false;
+    brand.assign(trimmed);
+    return true;
+}
+
+// Лист 0x16 (Intel Skylake+): EAX - базова, EBX - максимальна частота в MHz.
+// AMD та більшість гіпервізорів листа не мають або повертають нулі
+uint32_t cpuidFrequencyMHz()
+{
+    unsigned int eax = 0, ebx = 0, ecx = 0, edx = 0;
+    if (__get_cpuid_max(0, nullptr) < 0x16u || !__get_cpuid(0x16u, &eax, &ebx, &ecx, &edx))
+        return 0;
+
+    const uint32_t maxMHz = ebx & 0xFFFF;
+    const uint32_t baseMHz = eax & 0xFFFF;
+    return maxMHz > 0 ? maxMHz : baseMHz;
+}
+#endif
+
+} // namespace
+
+// ========================================
+// ОС та CPU - Linux
+// ========================================
+
+std::string DeviceCollector::osName() const
+{
+    // Той самий порядок джерел, що й у QSysInfo::prettyProductName()
+    std::string content;
+    for (const char* path : { "/etc/os-release", "/usr/lib/os-release" }) {
+        if (!readFileInto(path, content))
+            continue;
+
+        std::string_view text(content);
+        std::string_view line;
+        size_t pos = 0;
+        while (nextLine(text, pos, line)) {
+            if (line.compare(0, 12, "PRETTY_NAME=") != 0)
+                continue;
+            std::string_view value = line.substr(12);
+            if (value.size() >= 2 && (value.front() == '"' || value.front() == '\'') && value.back() == value.front())
+                value = value.substr(1, value.size() - 2);
+            if (!value.empty())
+                return std::string(value);
+        }
+    }
+    return "Linux " + kernelVersion();
+}
+
+std::string DeviceCollector::kernelVersion() const
+{
+    struct utsname name;
+    return uname(&name) == 0 ? std::string(name.release) : std::string();
+}
+
+std::string DeviceCollector::architecture() const
+{
+    struct utsname name;
+    if (uname(&name) != 0)
+        return std::string();
+
+    // Назви як у QSysInfo::currentCpuArchitecture()
+    std::string_view machine(name.machine);
+    if (machine == "aarch64") return "arm64";
+    if (machine.size() == 4 && machine[0] == 'i' && machine.substr(2) == "86") return "i386";
+    if (machine.compare(0, 3, "arm") == 0) return "arm";
+    return std::string(machine);
+}
+
+std::string DeviceCollector::cpuModel() const
+{
+#ifdef HWINFO_HAVE_CPUID
+    // Без /proc/cpuinfo: на великих машинах це мегабайти, які ядро генерує на кожне читання
+    std::string brand;
+    if (cpuidBrandString(brand))
+        return brand;
+#endif
+
+    std::string content;
+    if (!readFileInto("/proc/cpuinfo", content))
+        return std::string();
+
+    std::string_view text(content);
+    std::string_view line;
+    size_t pos = 0;
+    while (nextLine(text, pos, line)) {
+        if (line.compare(0, 10, "model name") != 0)
+            continue;
+        size_t colon = line.find(':');
+        if (colon != std::string_view::npos)
+            return std::string(trimView(line.substr(colon + 1)));
+    }
+    return std::string();
+}
+
+uint32_t DeviceCollector::cpuCores() const
+{
+    // Як QThread::idealThreadCount(): CPU, на яких процесу дозволено виконуватися
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if (sched_getaffinity(0, sizeof(set), &set) == 0 && CPU_COUNT(&set) > 0)
+        return static_cast<uint32_t>(CPU_COUNT(&set));
+
+    long online = sysconf(_SC_NPROCESSORS_ONLN);
+    return online > 0 ? static_cast<uint32_t>(online) : 1;
+}
+
+uint32_t DeviceCollector::cpuFrequencyMHz() const
+{
+#ifdef HWINFO_HAVE_CPUID
+    uint32_t mhz = cpuidFrequencyMHz();
+    if (mhz > 0)
+        return mhz;
+#endif
+
+    uint32_t khz = 0;
+    if (!readSysfsUInt("/sys/devices/system/cpu/cpu0/cpufreq/cpuinfo_max_freq", khz))
+        return 0;
+    return khz / 1000;
+}
+
+// ========================================
+// RAM - Linux
+// ========================================
+
+uint64_t DeviceCollector::totalRAM() const
+{
+    struct sysinfo info;
+    if (sysinfo(&info) == 0) {
+        return static_cast<uint64_t>(info.totalram) * info.mem_unit;
+    }
+    return 0;
+}
+
+uint64_t DeviceCollector::availableRAM() const
+{
+    struct sysinfo info;
+    if (sysinfo(&info) == 0) {
+        return static_cast<uint64_t>(info.freeram) * info.mem_unit;
+    }
+    return 0;
+}
+
+// ========================================
+// Ефективні ресурси та PSI - Linux
+// ========================================
+
+bool DeviceCollector::cgroupLimitsInto(CgroupLimits& limits) const
+{
+    // Тільки unified-ієрархія (cgroup v2)
+    if (access("/sys/fs/cgroup/cgroup.controllers", F_OK) != 0)
+        return false;
+
+    // Ліміти попереднього виклику скидаються, буфер path лишається
+    std::string path = std::move(limits.path);
+    limits = CgroupLimits();
+    limits.path = std::move(path);
+
+    char dir[PATH_MAX];
+    cgroupPathOfSelf(dir, sizeof(dir));
+    limits.path.assign(dir);
+
+    char file[PATH_MAX + 32];
+    char value[4096];
+
+    // cpuset.cpus.effective вже враховує обмеження предків
+    snprintf(file, sizeof(file), "%s/cpuset.cpus.effective", dir);
+    if (readFirstLine(file, value, sizeof(value)) && value[0] != '\0') {
+        limits.cpuset_cpus = countCpuList(value);
+    }
+
+    snprintf(file, sizeof(file), "%s/memory.current", dir);
+    std::optional<uint64_t> current = readCgroupBytes(file);
+    if (current.has_value()) {
+        limits.memory_current_mb = current.value() / 1024 / 1024;
+    }
+
+    // cpu.max та memory.* предків теж діють - беремо найжорсткіший ліміт по ієрархії
+    std::optional<uint64_t> memoryMax;
+    std::optional<uint64_t> memoryHigh;
+    auto keepMin = [](std::optional<uint64_t>& acc, const std::optional<uint64_t>& value) {
+        if (value.has_value() && (!acc.has_value() || value.value() < acc.value()))
+            acc = value;
+    };
+
+    const size_t rootLength = strlen(kCgroupRoot);
+    while (true) {
+        snprintf(file, sizeof(file), "%s/memory.max", dir);
+        keepMin(memoryMax, readCgroupBytes(file));
+        snprintf(file, sizeof(file), "%s/memory.high", dir);
+        keepMin(memoryHigh, readCgroupBytes(file));
+
+        // Формат: "<quota> <period>" або "max <period>"
+        unsigned long long quota = 0, period = 0;
+        snprintf(file, sizeof(file), "%s/cpu.max", dir);
+        readFirstLine(file, value, sizeof(value));
+        if (sscanf(value, "%llu %llu", &quota, &period) == 2 && period > 0) {
+            double cores = static_cast<double>(quota) / period;
+            if (!limits.cpu_quota_cores.has_value() || cores < limits.cpu_quota_cores.value()) {
+                limits.cpu_quota_us = quota;
+                limits.cpu_period_us = period;
+                limits.cpu_quota_cores = cores;
+            }
+        }
+
+        if (strlen(dir) <= rootLength)
+            break;
+        *strrchr(dir, '/') = '\0';
+    }
+
+    if (memoryMax.has_value()) limits.memory_max_mb = memoryMax.value() / 1024 / 1024;
+    if (memoryHigh.has_value()) limits.memory_high_mb = memoryHigh.value() / 1024 / 1024;
+
+    return true;
+}
+
+std::optional<SystemPressure> DeviceCollector::readPressure(const char* directory, const char* suffix) const
+{
+    // /proc/pressure/cpu або <cgroup>/cpu.pressure
+    char path[PATH_MAX + 32];
+    SystemPressure pressure;
+    snprintf(path, sizeof(path), "%scpu%s", directory, suffix);
+    pressure.cpu = readPressureFile(path);
+    snprintf(path, sizeof(path), "%smemory%s", directory, suffix);
+    pressure.memory = readPressureFile(path);
+    snprintf(path, sizeof(path), "%sio%s", directory, suffix);
+    pressure.io = readPressureFile(path);
+
+    // Ядро без CONFIG_PSI або psi=0
+    if (!pressure.cpu.has_value() && !pressure.memory.has_value() && !pressure.io.has_value())
+        return std::nullopt;
+    return pressure;
+}
+
+std::optional<SystemPressure> DeviceCollector::pressure() const
+{
+    return readPressure("/proc/pressure/", "");
+}
+
+std::optional<SystemPressure> DeviceCollector::cgroupPressure() const
+{
+    if (access("/sys/fs/cgroup/cgroup.controllers", F_OK) != 0)
+        return std::nullopt;
+
+    char directory[PATH_MAX + 1];
+    cgroupPathOfSelf(directory, sizeof(directory) - 1);
+    strcat(directory, "/");
+    return readPressure(directory, ".pressure");
+}
+
+// ========================================
+// GPU - Linux
+// ========================================
+
+bool DeviceCollector::lspciOutput(std::string& output) const
+{
+    pumpUevents();
+    return runCachedCommand("lspci", { "-v" }, 3000, inventoryTtl(kLspciTtl), output);
+}
+
+bool DeviceCollector::nvidiaSmiQuery(const std::string& fields, std::string& output) const
+{
+    return runCachedCommand("nvidia-smi", { "--query-gpu=" + fields, "--format=csv,noheader,nounits" },
+                            2000, kNvidiaSmiTtl, output);
+}
+
+std::vector<GPUInfo> DeviceCollector::gpuList() const
+{
+    std::vector<GPUInfo> gpuList;
+
+    std::string output;
+    if (!lspciOutput(output))
+        return gpuList;
+
+    std::string_view text(output);
+    std::string_view line;
+    size_t pos = 0;
+    while (nextLine(text, pos, line)) {
+        if (!containsNoCase(line, "VGA compatible controller:") && !containsNoCase(line, "3D controller:"))
+            continue;
+
+        size_t colonPos = line.rfind(':');
+        if (colonPos == std::string_view::npos || colonPos == 0)
+            continue;
+
+        GPUInfo gpu;
+        gpu.model = std::string(trimView(line.substr(colonPos + 1)));
+
+        // "01:00.0 VGA compatible controller: ..." - без -D lspci не друкує домен
+        std::string_view slot = line.substr(0, line.find(' '));
+        if (std::count(slot.begin(), slot.end(), ':') == 1)
+            gpu.pci_address = "0000:";
+        gpu.pci_address.append(slot.data(), slot.size());
+
+        std::string nvidiaOutput;
+        if (nvidiaSmiQuery("memory.total,memory.used,memory.free", nvidiaOutput)) {
+            // Перший рядок: "8192, 1024, 7168"
+            unsigned long long total = 0, used = 0, free = 0;
+            if (sscanf(nvidiaOutput.c_str(), "%llu ,%llu ,%llu", &total, &used, &free) == 3) {
+                gpu.vram_mb = total;
+                gpu.vram_used_mb = used;
+                gpu.vram_free_mb = free;
+                if (total > 0) {
+                    gpu.vram_usage_percent = (used * 100.0) / total;
+                }
+            }
+        }
+
+        gpuList.push_back(std::move(gpu));
+    }
+
+    return gpuList;
+}
+
+// ========================================
+// Диски - Linux
+// ========================================
+
+DiskType DeviceCollector::diskType(const std::string& device) const
+{
+    pumpUevents();
+
+    // Тип кожного диска живе до uevent цього диска (або до TTL без сокета)
+    const std::string devName = diskName(device);
+    const std::string typeKey = diskTypeKeyOf(devName);
+    std::string cachedType;
+    if (m_cache.lookup(typeKey, cachedType)) {
+        ProbeScope::noteCacheHit();
+        return diskTypeFromString(cachedType);
+    }
+
+    const std::string prefix = devName + " ";
+
+    // Кешується весь вивід lsblk: один запуск на всі диски, новий - після TTL або invalidateCache()
+    std::string output;
+    if (!runCachedCommand("lsblk", { "-d", "-o", "NAME,ROTA,TRAN,TYPE,MODEL" }, 1500, inventoryTtl(kLsblkTtl), output))
+        return DiskType::Unknown;
+
+    DiskType type = DiskType::Unknown;
+    std::string_view text(output);
+    std::string_view line;
+    size_t pos = 0;
+    while (type == DiskType::Unknown && nextLine(text, pos, line)) {
+        std::string_view trimmed = trimView(line);
+        if (trimmed.compare(0, prefix.size(), prefix) != 0)
+            continue;
+
+        // NAME ROTA TRAN TYPE MODEL... (порожній TRAN зсуває колонки, як і раніше)
+        std::string_view parts[4];
+        size_t count = 0;
+        size_t at = 0;
+        while (count < 4 && at < trimmed.size()) {
+            while (at < trimmed.size() && isspace(static_cast<unsigned char>(trimmed[at]))) ++at;
+            size_t end = at;
+            while (end < trimmed.size() && !isspace(static_cast<unsigned char>(trimmed[end]))) ++end;
+            if (end > at) parts[count++] = trimmed.substr(at, end - at);
+            at = end;
+        }
+        if (count < 2) continue;
+
+        std::string_view name = parts[0];
+        std::string_view rota = parts[1];
+        std::string_view tran = parts[2];
+        std::string_view kind = parts[3];
+
+        if (name.compare(0, 4, "nvme") == 0)
+            type = DiskType::SSD;
+        else if (equalsNoCase(kind, "rom") || equalsNoCase(kind, "loop"))
+            type = DiskType::Removable;
+        else if (containsNoCase(tran, "usb") || containsNoCase(tran, "thunderbolt"))
+            type = DiskType::External;
+        else if (rota == "0")
+            type = DiskType::SSD;
+        else if (rota == "1")
+            type = DiskType::HDD;
+    }
+
+    if (type == DiskType::Unknown) {
+        type = diskTypeFromString(rotationalDiskType(devName));
+    }
+
+    m_cache.store(typeKey, diskTypeName(type), inventoryTtl(kLsblkTtl));
+    return type;
+}
+
+std::string DeviceCollector::diskName(const std::string& device) const
+{
+    // Розділи, dm та символьні посилання - через sysfs; пристрою немає - за ім'ям
+    std::string disk = blockDevice(device);
+    return disk.empty() ? parentDiskName(device) : disk;
+}
+
+std::string DeviceCollector::diskTypeKey(const std::string& device) const
+{
+    return diskTypeKeyOf(diskName(device));
+}
+
+std::string DeviceCollector::blockDevice(const std::string& device) const
+{
+    // /dev/mapper/vg-root -> /dev/dm-0, /dev/disk/by-uuid/... -> /dev/sda1
+    char resolved[PATH_MAX];
+    if (realpath(device.c_str(), resolved) == nullptr)
+        return std::string();
+
+    std::string name = resolved;
+    if (name.rfind("/dev/", 0) != 0)
+        return std::string();
+    name.erase(0, 5);
+
+    // Для розділу /sys/class/block/<name> вказує на .../<disk>/<name>
+    std::string sysPath = "/sys/class/block/" + name;
+    if (access((sysPath + "/partition").c_str(), F_OK) == 0 &&
+        realpath(sysPath.c_str(), resolved) != nullptr) {
+        std::string partPath = resolved;
+        std::string parentPath = partPath.substr(0, partPath.rfind('/'));
+        return parentPath.substr(parentPath.rfind('/') + 1);
+    }
+
+    return name;
+}
+
+template <typename Visitor>
+void DeviceCollector::visitVolumes(bool detectType, Visitor&& visit) const
+{
+    if (detectType)
+        pumpUevents();
+
+    std::lock_guard<std::mutex> lock(m_volumesMutex);
+
+    if (m_volumeTypesStale.exchange(false))
+        m_volumes.typed = false;
+    bool rebuild = m_mountWatcher.changed() || !m_volumes.valid || (detectType && !m_volumes.typed);
+    if (!rebuild && refreshVolumeUsage(m_volumes.volumes)) {
+        ProbeScope::noteCacheHit();
+        visit(m_volumes.volumes);
+        return;
+    }
+
+    m_volumes.volumes = enumerateVolumes(detectType);
+    m_volumes.typed = detectType;
+    m_volumes.valid = true;
+    visit(m_volumes.volumes);
+}
+
+std::vector<VolumeInfo> DeviceCollector::volumes(bool detectType) const
+{
+    std::vector<VolumeInfo> result;
+    visitVolumes(detectType, [&result](const std::vector<VolumeInfo>& volumes) { result = volumes; });
+    return result;
+}
+
+std::vector<VolumeInfo> DeviceCollector::enumerateVolumes(bool detectType) const
+{
+    std::vector<VolumeInfo> result;
+
+    std::string content;
+    if (!readFileInto("/proc/self/mountinfo", content))
+        return result;
+
+    // "36 35 98:0 /root /mnt rw,noatime master:1 - ext4 /dev/sda1 rw,errors=continue"
+    std::string_view text(content);
+    std::string_view line;
+    size_t pos = 0;
+    while (nextLine(text, pos, line)) {
+        std::string_view fields[5];
+        size_t count = 0;
+        size_t at = 0;
+        while (count < 5 && at <= line.size()) {
+            size_t end = line.find(' ', at);
+            if (end == std::string_view::npos) end = line.size();
+            fields[count++] = line.substr(at, end - at);
+            at = end + 1;
+        }
+        size_t separator = line.find(" - ");
+        if (count < 5 || separator == std::string_view::npos)
+            continue;
+
+        std::string_view tail = line.substr(separator + 3);
+        size_t typeEnd = tail.find(' ');
+        if (typeEnd == std::string_view::npos)
+            continue;
+        std::string_view fsType = tail.substr(0, typeEnd);
+        std::string_view source = tail.substr(typeEnd + 1);
+        source = source.substr(0, source.find(' '));
+
+        if (isPseudoFilesystem(fsType) || fsType == "tmpfs" || fsType == "devtmpfs" ||
+            fsType == "squashfs" || fsType == "overlay") {
+            continue;
+        }
+
+        std::string mount = unescapeMountField(fields[4]);
+        if (mount.rfind("/boot", 0) == 0 || mount.rfind("/sys", 0) == 0 ||
+            mount.rfind("/proc", 0) == 0 || mount.rfind("/dev", 0) == 0 ||
+            mount.rfind("/run", 0) == 0) {
+            continue;
+        }
+
+        struct statvfs fs;
+        if (statvfs(mount.c_str(), &fs) != 0 || (fs.f_flag & ST_RDONLY) != 0 || fs.f_blocks == 0)
+            continue;
+
+        VolumeInfo volume;
+        volume.mount_point = std::move(mount);
+        volume.filesystem.assign(fsType.data(), fsType.size());
+        volume.device = unescapeMountField(source);
+        volume.total_bytes = static_cast<uint64_t>(fs.f_blocks) * fs.f_frsize;
+        volume.free_bytes = static_cast<uint64_t>(fs.f_bfree) * fs.f_frsize;
+        volume.used_bytes = volume.total_bytes - volume.free_bytes;
+        volume.usage_percent = (volume.used_bytes * 100.0) / volume.total_bytes;
+
+        if (detectType) {
+            volume.type = diskType(volume.device);
+            volume.block_device = blockDevice(volume.device);
+        }
+
+        result.push_back(std::move(volume));
+    }
+
+    return result;
+}
+
+void DeviceCollector::diskIOStatsInto(std::vector<DiskIOStats>& out) const
+{
+    // Вибірка та оновлення базової лінії - атомарно щодо інших потоків
+    std::lock_guard<std::mutex> lock(m_diskStatsMutex);
+    if (!readFileInto("/proc/diskstats", m_diskStatsBuffer)) {
+        out.clear();
+        return;
+    }
+
+    auto now = std::chrono::steady_clock::now();
+    double elapsedMs = std::chrono::duration<double, std::milli>(now - m_prevDiskStatsTime).count();
+    bool haveBaseline = !m_prevDiskStats.empty() && elapsedMs > 0.0;
+
+    for (DiskStatsEntry& entry : m_prevDiskStats) {
+        entry.seen = false;
+    }
+
+    size_t count = 0;
+    std::string_view text(m_diskStatsBuffer);
+    std::string_view view;
+    size_t pos = 0;
+    while (nextLine(text, pos, view)) {
+        // sscanf не має вийти за межі рядка
+        char line[512];
+        size_t length = std::min(view.size(), sizeof(line) - 1);
+        memcpy(line, view.data(), length);
+        line[length] = '\0';
+
+        // major minor name reads merged sectors ms writes merged sectors ms in_flight io_ms weighted_ms ...
+        char name[64];
+        unsigned long long reads, readsMerged, sectorsRead, readMs;
+        unsigned long long writes, writesMerged, sectorsWritten, writeMs;
+        unsigned long long inFlight, ioMs, weightedMs;
+        unsigned int major, minor;
+        int fields = sscanf(line,
+            "%u %u %63s %llu %llu %llu %llu %llu %llu %llu %llu %llu %llu %llu",
+            &major, &minor, name,
+            &reads, &readsMerged, &sectorsRead, &readMs,
+            &writes, &writesMerged, &sectorsWritten, &writeMs,
+            &inFlight, &ioMs, &weightedMs);
+        if (fields < 14)
+            continue;
+
+        // Тільки цілі пристрої з /sys/block (без розділів), без loop та ramdisk
+        if (strncmp(name, "loop", 4) == 0 || strncmp(name, "ram", 3) == 0)
+            continue;
+        char sysPath[96];
+        snprintf(sysPath, sizeof(sysPath), "/sys/block/%s", name);
+        if (access(sysPath, F_OK) != 0)
+            continue;
+
+        // Елемент попереднього виклику скидається, буфер device лишається
+        if (count == out.size())
+            out.emplace_back();
+        DiskIOStats& io = out[count++];
+        std::string device = std::move(io.device);
+        io = DiskIOStats();
+        io.device = std::move(device);
+
+        // Сектор у /proc/diskstats завжди 512 байт незалежно від пристрою
+        io.device.assign(name);
+        io.reads_completed = reads;
+        io.writes_completed = writes;
+        io.read_bytes = sectorsRead * 512;
+        io.write_bytes = sectorsWritten * 512;
+        io.in_flight = static_cast<uint32_t>(inFlight);
+
+        DiskStatsEntry* prevEntry = nullptr;
+        for (DiskStatsEntry& candidate : m_prevDiskStats) {
+            if (candidate.name == io.device) {
+                prevEntry = &candidate;
+                break;
+            }
+        }
+
+        if (haveBaseline && prevEntry != nullptr) {
+            const DiskStatsCounters& prev = prevEntry->counters;
+            // Лічильники скинулися (пристрій перепідключено) - швидкостей немає
+            if (reads >= prev.reads && writes >= prev.writes && ioMs >= prev.ioMs &&
+                sectorsRead >= prev.sectorsRead && sectorsWritten >= prev.sectorsWritten) {
+                double seconds = elapsedMs / 1000.0;
+                uint64_t dReads = reads - prev.reads;
+                uint64_t dWrites = writes - prev.writes;
+                uint64_t dOps = dReads + dWrites;
+
+                io.read_mb_per_sec = (sectorsRead - prev.sectorsRead) * 512.0 / 1024 / 1024 / seconds;
+                io.write_mb_per_sec = (sectorsWritten - prev.sectorsWritten) * 512.0 / 1024 / 1024 / seconds;
+                io.read_iops = dReads / seconds;
+                io.write_iops = dWrites / seconds;
+                io.await_ms = dOps > 0
+                    ? static_cast<double>((readMs - prev.readMs) + (writeMs - prev.writeMs)) / dOps
+                    : 0.0;
+                io.avg_queue_depth = (weightedMs - prev.weightedMs) / elapsedMs;
+                io.util_percent = std::min(100.0, (ioMs - prev.ioMs) * 100.0 / elapsedMs);
+            }
+        }
+
+        if (prevEntry == nullptr) {
+            m_prevDiskStats.push_back(DiskStatsEntry());
+            prevEntry = &m_prevDiskStats.back();
+            prevEntry->name = io.device;
+        }
+        prevEntry->counters = { reads, sectorsRead, readMs,
+                                writes, sectorsWritten, writeMs,
+                                ioMs, weightedMs };
+        prevEntry->seen = true;
+    }
+    out.resize(count);
+
+    // Пристрої, що зникли, більше не тримаємо
+    m_prevDiskStats.erase(std::remove_if(m_prevDiskStats.begin(), m_prevDiskStats.end(),
+        [](const DiskStatsEntry& entry) { return !entry.seen; }), m_prevDiskStats.end());
+    m_prevDiskStatsTime = now;
+}
+
+// ========================================
+// Мережа та енергоспоживання - Linux
+// ========================================
+
+void DeviceCollector::networkInterfacesInto(std::vector<NetInterfaceInfo>& out) const
+{
+    std::lock_guard<std::mutex> lock(m_netDevMutex);
+    if (!readFileInto("/proc/net/dev", m_netDevBuffer)) {
+        out.clear();
+        return;
+    }
+
+    auto now = std::chrono::steady_clock::now();
+    double seconds = std::chrono::duration<double>(now - m_prevNetDevTime).count();
+    bool haveBaseline = !m_prevNetDev.empty() && seconds > 0.0;
+
+    for (NetDevCounters& prev : m_prevNetDev) {
+        prev.seen = false;
+    }
+    size_t count = 0;
+
+    // Формат рядка: "  eth0: rx_bytes rx_packets errs drop fifo frame compressed multicast
+    //                        tx_bytes tx_packets errs drop fifo colls carrier compressed"
+    // Перші два рядки - заголовок таблиці
+    const char* p = m_netDevBuffer.data();
+    const char* fileEnd = p + m_netDevBuffer.size();
+    for (int header = 0; header < 2 && p < fileEnd; ++header) {
+        const char* nl = static_cast<const char*>(memchr(p, '\n', fileEnd - p));
+        p = nl ? nl + 1 : fileEnd;
+    }
+
+    while (p < fileEnd) {
+        const char* lineEnd = static_cast<const char*>(memchr(p, '\n', fileEnd - p));
+        if (!lineEnd) lineEnd = fileEnd;
+
+        while (p < lineEnd && *p == ' ') ++p;
+        const char* colon = static_cast<const char*>(memchr(p, ':', lineEnd - p));
+        if (!colon) {
+            p = lineEnd + 1;
+            continue;
+        }
+        std::string_view name(p, colon - p);
+
+        uint64_t fields[16] = {};
+        const char* q = colon + 1;
+        int parsed = 0;
+        for (; parsed < 16; ++parsed) {
+            char* end = nullptr;
+            fields[parsed] = strtoull(q, &end, 10);
+            if (end == q || end > lineEnd) break;
+            q = end;
+        }
+        p = lineEnd + 1;
+        if (parsed < 16)
+            continue;
+
+        // Елемент попереднього виклику скидається, буфер name лишається
+        if (count == out.size())
+            out.emplace_back();
+        NetInterfaceInfo& nic = out[count++];
+        std::string nicName = std::move(nic.name);
+        nic = NetInterfaceInfo();
+        nic.name = std::move(nicName);
+        nic.name.assign(name.data(), name.size());
+        nic.rx_bytes = fields[0];
+        nic.rx_packets = fields[1];
+        nic.rx_errors = fields[2];
+        nic.rx_drops = fields[3];
+        nic.tx_bytes = fields[8];
+        nic.tx_packets = fields[9];
+        nic.tx_errors = fields[10];
+        nic.tx_drops = fields[11];
+
+        char path[128];
+        uint32_t value = 0;
+        snprintf(path, sizeof(path), "/sys/class/net/%.*s/speed", static_cast<int>(name.size()), name.data());
+        if (readSysfsUInt(path, value) && value > 0) nic.speed_mbps = value;
+        snprintf(path, sizeof(path), "/sys/class/net/%.*s/mtu", static_cast<int>(name.size()), name.data());
+        if (readSysfsUInt(path, value)) nic.mtu = value;
+
+        NetDevCounters* prev = nullptr;
+        for (NetDevCounters& candidate : m_prevNetDev) {
+            if (candidate.name == name) {
+                prev = &candidate;
+                break;
+            }
+        }
+
+        // Лічильники скинулися (інтерфейс перестворено) - швидкостей немає
+        if (haveBaseline && prev != nullptr &&
+            nic.rx_bytes >= prev->rxBytes && nic.tx_bytes >= prev->txBytes &&
+            nic.rx_packets >= prev->rxPackets && nic.tx_packets >= prev->txPackets &&
+            nic.rx_errors >= prev->rxErrors && nic.tx_errors >= prev->txErrors &&
+            nic.rx_drops >= prev->rxDrops && nic.tx_drops >= prev->txDrops) {
+            nic.rx_mb_per_sec = (nic.rx_bytes - prev->rxBytes) / 1024.0 / 1024.0 / seconds;
+            nic.tx_mb_per_sec = (nic.tx_bytes - prev->txBytes) / 1024.0 / 1024.0 / seconds;
+            nic.rx_packets_per_sec = (nic.rx_packets - prev->rxPackets) / seconds;
+            nic.tx_packets_per_sec = (nic.tx_packets - prev->txPackets) / seconds;
+            nic.rx_errors_per_sec = (nic.rx_errors - prev->rxErrors) / seconds;
+            nic.tx_errors_per_sec = (nic.tx_errors - prev->txErrors) / seconds;
+            nic.rx_drops_per_sec = (nic.rx_drops - prev->rxDrops) / seconds;
+            nic.tx_drops_per_sec = (nic.tx_drops - prev->txDrops) / seconds;
+
+            if (nic.speed_mbps.has_value()) {
+                // speed - у мегабітах (10^6 біт/с)
+                double rxMbit = (nic.rx_bytes - prev->rxBytes) * 8.0 / 1e6 / seconds;
+                double txMbit = (nic.tx_bytes - prev->txBytes) * 8.0 / 1e6 / seconds;
+                nic.link_usage_percent = std::max(rxMbit, txMbit) * 100.0 / nic.speed_mbps.value();
+            }
+        }
+
+        if (prev == nullptr) {
+            m_prevNetDev.push_back(NetDevCounters());
+            prev = &m_prevNetDev.back();
+            prev->name = nic.name;
+        }
+        prev->rxBytes = nic.rx_bytes;
+        prev->rxPackets = nic.rx_packets;
+        prev->rxErrors = nic.rx_errors;
+        prev->rxDrops = nic.rx_drops;
+        prev->txBytes = nic.tx_bytes;
+        prev->txPackets = nic.tx_packets;
+        prev->txErrors = nic.tx_errors;
+        prev->txDrops = nic.tx_drops;
+        prev->seen = true;
+    }
+    out.resize(count);
+
+    // Інтерфейси, що зникли, більше не тримаємо
+    m_prevNetDev.erase(std::remove_if(m_prevNetDev.begin(), m_prevNetDev.end(),
+        [](const NetDevCounters& c) { return !c.seen; }), m_prevNetDev.end());
+    m_prevNetDevTime = now;
+}
+
+void DeviceCollector::powerDomainsInto(std::vector<PowerDomainInfo>& out) const
+{
+    std::lock_guard<std::mutex> lock(m_energyMutex);
+
+    if (!m_powerZonesScanned) {
+        // intel-rapl:0 (package), intel-rapl:0:0 (core), intel-rapl:0:2 (dram), intel-rapl-mmio:0;
+        // сам "intel-rapl" - це control type без лічильника
+        m_powerZones.clear();
+        for (const std::string& zone : listDirectory("/sys/class/powercap", "intel-rapl*:*")) {
+            char path[128];
+            char name[64];
+            snprintf(path, sizeof(path), "/sys/class/powercap/%s/name", zone.c_str());
+            readFirstLine(path, name, sizeof(name));
+            m_powerZones.push_back(PowerZone{ zone, name, 0, false });
+        }
+        m_powerZonesScanned = true;
+    }
+
+    auto now = std::chrono::steady_clock::now();
+    double seconds = std::chrono::duration<double>(now - m_prevEnergyTime).count();
+
+    size_t count = 0;
+    for (PowerZone& zone : m_powerZones) {
+        char path[128];
+        uint64_t energy = 0;
+        snprintf(path, sizeof(path), "/sys/class/powercap/%s/energy_uj", zone.zone.c_str());
+        if (!readSysfsUInt64(path, energy)) {
+            zone.hasPrev = false;
+            continue;
+        }
+
+        if (count == out.size())
+            out.emplace_back();
+        PowerDomainInfo& domain = out[count++];
+        domain.zone.assign(zone.zone);
+        domain.name.assign(zone.name);
+        domain.energy_uj = energy;
+        domain.power_w.reset();
+
+        if (zone.hasPrev && seconds > 0.0) {
+            uint64_t prev = zone.prevEnergy;
+            uint64_t maxRange = 0;
+            snprintf(path, sizeof(path), "/sys/class/powercap/%s/max_energy_range_uj", zone.zone.c_str());
+            if (energy >= prev) {
+                domain.power_w = (energy - prev) / 1e6 / seconds;
+            }
+            else if (readSysfsUInt64(path, maxRange) && maxRange >= prev) {
+                // Лічильник переповнився і почав з нуля (на package ~ раз на кілька хвилин)
+                domain.power_w = ((maxRange - prev) + energy) / 1e6 / seconds;
+            }
+            // Інакше дельта невідома - power_w лишається порожнім, а не 0 W
+        }
+
+        zone.prevEnergy = energy;
+        zone.hasPrev = true;
+    }
+    out.resize(count);
+
+    m_prevEnergyTime = now;
+}
+
+// ========================================
+// Hotplug (uevent) - Linux
+// ========================================
+
+void DeviceCollector::pumpUevents() const
+{
+    if (!m_uevents || !m_uevents->isValid())
+        return;
+    std::lock_guard<std::mutex> lock(m_ueventMutex);
+    m_uevents->poll();
+}
+
+void DeviceCollector::applyUevent(const Uevent& event) const
+{
+    if (event.action == "overflow") {
+        // Частину подій втрачено - статичний інвентар перечитується при наступному запиті
+        m_cache.invalidatePrefix("cmd:lsblk");
+        m_cache.invalidatePrefix("cmd:lspci");
+        m_cache.invalidatePrefix("disktype:");
+        m_volumeTypesStale.store(true);
+        m_sensorsStale.store(true);
+        return;
+    }
+
+    // hwmon з'являється і зникає разом з драйвером (amdgpu, nvme, модулі
+    // сенсорів); drm - разом з відеокартою, чий hwmon ще може не мати події
+    const bool sensorsChanged = event.action == "add" || event.action == "remove";
+    if (event.subsystem == "hwmon") {
+        if (sensorsChanged)
+            m_sensorsStale.store(true);
+        return;
+    }
+    if (event.subsystem == "drm" && sensorsChanged)
+        m_sensorsStale.store(true);
+
+    if (event.subsystem == "block") {
+        // Інвалідуються лише цей диск (і батьківський для розділу); решта типів лишається.
+        // Ключі - за цілим диском, як у diskType(), тож подія nvme0n1 скидає і nvme0n1p2
+        m_cache.invalidate(diskTypeKeyOf(parentDiskName(event.devname)));
+        if (event.devtype == "partition") {
+            size_t slash = event.devpath.find_last_of('/');
+            if (slash != std::string::npos && slash > 0) {
+                size_t parentStart = event.devpath.find_last_of('/', slash - 1);
+                parentStart = (parentStart == std::string::npos) ? 0 : parentStart + 1;
+                m_cache.invalidate(diskTypeKeyOf(event.devpath.substr(parentStart, slash - parentStart)));
+            }
+        }
+        m_cache.invalidatePrefix("cmd:lsblk");
+        m_volumeTypesStale.store(true);
+    }
+    else if (event.subsystem == "drm" || isDisplayController(event.pci_class)) {
+        m_cache.invalidatePrefix("cmd:lspci");
+    }
+}
+
+std::chrono::milliseconds DeviceCollector::inventoryTtl(std::chrono::milliseconds fallback) const
+{
+    return (m_uevents && m_uevents->isValid()) ? kHotplugTrackedTtl : fallback;
+}
+
+#else
+// ========================================
+// Інші платформи - проби без даних (їх реалізує адаптер)
+// ========================================
+
+std::string DeviceCollector::osName() const { return std::string(); }
+std::string DeviceCollector::kernelVersion() const { return std::string(); }
+std::string DeviceCollector::architecture() const { return std::string(); }
+std::string DeviceCollector::cpuModel() const { return std::string(); }
+uint32_t DeviceCollector::cpuCores() const { return std::max(1u, std::thread::hardware_concurrency()); }
+uint32_t DeviceCollector::cpuFrequencyMHz() const { return 0; }
+uint64_t DeviceCollector::totalRAM() const { return 0; }
+uint64_t DeviceCollector::availableRAM() const { return 0; }
+std::optional<SystemPressure> DeviceCollector::pressure() const { return std::nullopt; }
+std::optional<SystemPressure> DeviceCollector::cgroupPressure() const { return std::nullopt; }
+std::vector<GPUInfo> DeviceCollector::gpuList() const { return std::vector<GPUInfo>(); }
+std::vector<VolumeInfo> DeviceCollector::volumes(bool) const { return std::vector<VolumeInfo>(); }
+bool DeviceCollector::cgroupLimitsInto(CgroupLimits&) const { return false; }
+void DeviceCollector::diskIOStatsInto(std::vector<DiskIOStats>& out) const { out.clear(); }
+void DeviceCollector::networkInterfacesInto(std::vector<NetInterfaceInfo>& out) const { out.clear(); }
+void DeviceCollector::powerDomainsInto(std::vector<PowerDomainInfo>& out) const { out.clear(); }
+DiskType DeviceCollector::diskType(const std::string&) const { return DiskType::Unknown; }
+std::string DeviceCollector::blockDevice(const std::string&) const { return std::string(); }
+std::string DeviceCollector::diskTypeKey(const std::string&) const { return std::string(); }
+bool DeviceCollector::lspciOutput(std::string&) const { return false; }
+bool DeviceCollector::nvidiaSmiQuery(const std::string&, std::string&) const { return false; }
+
+template <typename Visitor>
+void DeviceCollector::visitVolumes(bool, Visitor&& visit) const
+{
+    static const std::vector<VolumeInfo> kNoVolumes;
+    visit(kNoVolumes);
+}
+#endif
+
+// ========================================
+// Збір ArgentumDevice
+// ========================================
+
+ArgentumDevice DeviceCollector::collect(const CollectOptions& options, CollectionStats* stats,
+                                        const std::function<bool()>& isCanceled) const
+{
+    ArgentumDevice device;
+    collectInto(device, options, stats, isCanceled);
+    return device;
+}
+
+void DeviceCollector::collectInto(ArgentumDevice& device, const CollectOptions& requested, CollectionStats* stats,
+                                  const std::function<bool()>& isCanceled) const
+{
+    CollectOptions options = requested.resolved();
+    CancelCheckGuard cancelGuard(isCanceled);
+    if (stats) *stats = CollectionStats();
+
+    // Секція потрібна і збір не скасовано
+    auto wanted = [&options](DeviceField field) {
+        return options.has(field) && !collectionCanceled();
+    };
+    auto collectionStart = std::chrono::steady_clock::now();
+
+    // Поля незапитаних секцій скидаються - device має той самий вигляд, що й після collect()
+
+    // ========== OS ==========
+    if (wanted(DeviceField::OS)) {
+        ProbeScope probe(stats, "os", ProbeSource::SystemApi);
+        const Identity& id = identity();
+        device.os.assign(id.os);
+        assignOptional(device.os_kernel, id.kernel);
+        assignOptional(device.os_arch, id.arch);
+#ifdef __linux__
+        assignOptional(device.platform, "Linux");
+#else
+        device.platform.reset();
+#endif
+    }
+    else {
+        device.os.clear();
+        device.os_kernel.reset();
+        device.os_arch.reset();
+        device.platform.reset();
+    }
+
+    // ========== CPU ==========
+    if (wanted(DeviceField::CPU)) {
+        ProbeScope probe(stats, "cpu", ProbeSource::SystemApi);
+        const Identity& id = identity();
+        const std::string& model = id.cpuModel;
+        if (model.empty()) {
+            ProbeScope::noteOutcome(ProbeOutcome::Missing);
+            assignOptional(device.cpu_model, "Unknown CPU");
+        }
+        else {
+            assignOptional(device.cpu_model, model);
+        }
+        device.cpu_cores = cpuCores();
+
+        if (id.cpuFrequencyMHz > 0) device.cpu_frequency_mhz = id.cpuFrequencyMHz;
+        else device.cpu_frequency_mhz.reset();
+    }
+    else {
+        device.cpu_model.reset();
+        device.cpu_cores = 0;
+        device.cpu_frequency_mhz.reset();
+    }
+
+    // ========== RAM ==========
+    uint64_t totalBytes = 0;
+    if (wanted(DeviceField::RAM)) {
+        ProbeScope probe(stats, "ram", ProbeSource::SystemApi);
+        totalBytes = totalRAM();
+        uint64_t availableBytes = availableRAM();
+        uint64_t usedBytes = totalBytes > availableBytes ? totalBytes - availableBytes : 0;
+
+        device.ram_mb = totalBytes / 1024 / 1024;
+        device.ram_available_mb = availableBytes / 1024 / 1024;
+        device.ram_used_mb = usedBytes / 1024 / 1024;
+        if (totalBytes > 0) device.ram_usage_percent = (usedBytes * 100.0) / totalBytes;
+        else device.ram_usage_percent.reset();
+    }
+    else {
+        device.ram_mb = 0;
+        device.ram_available_mb.reset();
+        device.ram_used_mb.reset();
+        device.ram_usage_percent.reset();
+    }
+
+    // ========== Ефективні ресурси (cgroup v2) ==========
+    device.effective_cpu_cores.reset();
+    device.effective_ram_mb.reset();
+    if (wanted(DeviceField::Cgroup)) {
+        ProbeScope probe(stats, "cgroup", ProbeSource::Sysfs);
+        if (!device.cgroup.has_value())
+            device.cgroup.emplace();
+        if (cgroupLimitsInto(*device.cgroup)) {
+            device.effective_cpu_cores = effectiveCPUCores(device.cpu_cores, device.cgroup);
+            device.effective_ram_mb = effectiveRAM(totalBytes, device.cgroup) / 1024 / 1024;
+        }
+        else {
+            ProbeScope::noteOutcome(ProbeOutcome::Missing);
+            device.cgroup.reset();
+        }
+    }
+    else {
+        device.cgroup.reset();
+    }
+
+    // ========== Pressure Stall Information ==========
+    if (wanted(DeviceField::Pressure)) {
+        ProbeScope probe(stats, "pressure", ProbeSource::Procfs);
+        device.pressure = pressure();
+        device.cgroup_pressure = cgroupPressure();
+        if (!device.pressure.has_value()) ProbeScope::noteOutcome(ProbeOutcome::Missing);
+    }
+    else {
+        device.pressure.reset();
+        device.cgroup_pressure.reset();
+    }
+
+    // ========== GPU ==========
+    // Інвентар з lspci/nvidia-smi через SourceCache - ця секція алокує завжди
+    if (wanted(DeviceField::GPU)) {
+        ProbeScope probe(stats, "gpu", ProbeSource::SystemApi);
+        device.gpus = gpuList();
+        if (device.gpus.empty()) ProbeScope::noteOutcome(ProbeOutcome::Missing);
+        device.gpu_count = static_cast<uint32_t>(device.gpus.size());
+    }
+    else {
+        device.gpus.clear();
+        device.gpu_count.reset();
+    }
+
+    // ========== Сенсори ==========
+    if (wanted(DeviceField::Sensors)) {
+        ProbeScope probe(stats, "sensors", ProbeSource::Sysfs);
+        refreshSensors();
+        m_sensors->readInto(device.sensors);
+        if (device.sensors.empty()) ProbeScope::noteOutcome(ProbeOutcome::Missing);
+
+        // hwmon відеокарти (amdgpu, nouveau, i915) - прив'язка за PCI-адресою
+        for (GPUInfo& gpu : device.gpus) {
+            for (const SensorReading& sensor : device.sensors) {
+                if (!gpu.pci_address.empty() && sensor.device == gpu.pci_address) {
+                    gpu.sensors.push_back(sensor);
+                }
+            }
+        }
+    }
+    else {
+        device.sensors.clear();
+    }
+
+    // ========== Диски ==========
+    // Один перелік томів на весь збір: і для списку дисків, і для підсумку.
+    // Записи переписуються під м'ютексом переліку, без його копії
+    bool listDisks = wanted(DeviceField::Disks);
+    bool listSpace = !listDisks && wanted(DeviceField::DiskSpace);
+    uint64_t totalDisk = 0;
+    uint64_t freeDisk = 0;
+    uint64_t usedDisk = 0;
+    size_t diskCount = 0;
+    device.primary_disk_type = DiskType::Unknown;
+    if (listDisks || listSpace) {
+        ProbeScope probe(stats, listDisks ? "disks" : "disk_space", ProbeSource::SystemApi);
+        visitVolumes(listDisks, [&](const std::vector<VolumeInfo>& volumes) {
+            for (const VolumeInfo& volume : volumes) {
+                totalDisk += volume.total_bytes;
+                freeDisk += volume.free_bytes;
+                usedDisk += volume.used_bytes;
+                if (!listDisks)
+                    continue;
+
+                if (diskCount == device.disks.size())
+                    device.disks.emplace_back();
+                DiskInfo& disk = device.disks[diskCount++];
+                disk.mount_point.assign(volume.mount_point);
+                disk.filesystem.assign(volume.filesystem);
+                disk.type = volume.type;
+                disk.total_mb = volume.total_bytes / 1024 / 1024;
+                disk.free_mb = volume.free_bytes / 1024 / 1024;
+                disk.used_mb = volume.used_bytes / 1024 / 1024;
+                disk.usage_percent = volume.usage_percent;
+                disk.free_percent = 100.0 - volume.usage_percent;
+                disk.block_device.assign(volume.block_device);
+
+                if (volume.mount_point == "/") {
+                    device.primary_disk_type = volume.type;
+                }
+            }
+        });
+    }
+    device.disks.resize(diskCount);
+
+    if (wanted(DeviceField::DiskIO)) {
+        ProbeScope probe(stats, "disk_io", ProbeSource::Procfs);
+        diskIOStatsInto(device.disk_io);
+        if (device.disk_io.empty()) ProbeScope::noteOutcome(ProbeOutcome::Missing);
+    }
+    else {
+        device.disk_io.clear();
+    }
+
+    // Прив'язка розділу до I/O його фізичного диску
+    for (DiskInfo& disk : device.disks) {
+        const DiskIOStats* match = nullptr;
+        for (const DiskIOStats& io : device.disk_io) {
+            if (!disk.block_device.empty() && io.device == disk.block_device) {
+                match = &io;
+                break;
+            }
+        }
+        if (match == nullptr) disk.io.reset();
+        else if (disk.io.has_value()) *disk.io = *match;
+        else disk.io = *match;
+    }
+
+    // Підсумок по дискам
+    if (options.has(DeviceField::DiskSpace)) {
+        device.total_disk_mb = totalDisk / 1024 / 1024;
+        device.free_disk_mb = freeDisk / 1024 / 1024;
+        device.used_disk_mb = usedDisk / 1024 / 1024;
+        if (totalDisk > 0) device.disk_usage_percent = (usedDisk * 100.0) / totalDisk;
+        else device.disk_usage_percent.reset();
+    }
+    else {
+        device.total_disk_mb.reset();
+        device.free_disk_mb.reset();
+        device.used_disk_mb.reset();
+        device.disk_usage_percent.reset();
+    }
+
+    // ========== Мережа ==========
+    if (wanted(DeviceField::Network)) {
+        ProbeScope probe(stats, "network", ProbeSource::Procfs);
+        networkInterfacesInto(device.network);
+        if (device.network.empty()) ProbeScope::noteOutcome(ProbeOutcome::Missing);
+    }
+    else {
+        device.network.clear();
+    }
+
+    // ========== Енергоспоживання (RAPL) ==========
+    device.package_power_w.reset();
+    if (wanted(DeviceField::Power)) {
+        ProbeScope probe(stats, "power", ProbeSource::Sysfs);
+        powerDomainsInto(device.power_domains);
+        if (device.power_domains.empty()) ProbeScope::noteOutcome(ProbeOutcome::Missing);
+        // Сума лише коли відома потужність кожного package - часткова сума занижує
+        bool complete = true;
+        for (const PowerDomainInfo& domain : device.power_domains) {
+            if (domain.name.rfind("package", 0) != 0)
+                continue;
+            if (!domain.power_w.has_value()) {
+                complete = false;
+                break;
+            }
+            device.package_power_w = device.package_power_w.value_or(0.0) + domain.power_w.value();
+        }
+        if (!complete)
+            device.package_power_w.reset();
+    }
+    else {
+        device.power_domains.clear();
+    }
+
+    if (stats) {
+        stats->total_duration_us = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - collectionStart).count());
+    }
+}
@@ -0,0 +1,222 @@
+#ifndef DEVICECOLLECTOR_H
+#define DEVICECOLLECTOR_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+#include "DeviceInfo.h"
+#include "CollectionStats.h"
+#include "MountWatcher.h"
+#include "SensorCollector.h"
+#include "SourceCache.h"
+#include "UeventMonitor.h"
+
+// ========================================
+// Змонтований том (байти, на відміну від DiskInfo)
+// ========================================
+struct VolumeInfo {
+    std::string mount_point;     // /, /home
+    std::string filesystem;      // ext4, btrfs
+    std::string device;          // /dev/nvme0n1p2, /dev/mapper/vg-root
+    std::string block_device;    // nvme0n1 - фізичний диск (лише з detectType)
+    DiskType type = DiskType::Unknown;        // Лише з detectType
+    uint64_t total_bytes = 0;
+    uint64_t free_bytes = 0;
+    uint64_t used_bytes = 0;
+    double usage_percent = 0.0;
+};
+
+// ========================================
+// Клас DeviceCollector - ядро збору без Qt (бібліотека hwinfo_core)
+// ========================================
+//
+// Linux-проби на POSIX, std::string_view та std::vector: /proc, /sys,
+// statvfs, утиліти через ProcessRunner. Не потребує QCoreApplication -
+// його можна лінкувати в сервіси без Qt. HardwareInfoProvider - Qt-адаптер
+// над цим класом. На інших платформах проби повертають порожні значення.
+//
+// Потокобезпечний: кеш утиліт (SourceCache) шардований, стан для
+// швидкостей (diskstats, net/dev, RAPL) та перелік томів мають окремий
+// м'ютекс на кожне джерело. Швидкості рахуються між двома будь-якими
+// сусідніми викликами, незалежно від потоку.
+class DeviceCollector
+{
+public:
+    DeviceCollector();
+    ~DeviceCollector();
+
+    DeviceCollector(const DeviceCollector&) = delete;
+    DeviceCollector& operator=(const DeviceCollector&) = delete;
+
+    // Лише запитані секції та їхні залежності; isCanceled перевіряється між
+    // секціями і всередині запущених утиліт
+    ArgentumDevice collect(const CollectOptions& options = CollectOptions(), CollectionStats* stats = nullptr,
+                           const std::function<bool()>& isCanceled = {}) const;
+
+    // Те саме, що collect(), але в device попереднього виклику: рядки та
+    // вектори переписуються на місці зі збереженням ємності. Повторний збір
+    // з тією самою маскою без GPU (lspci/nvidia-smi) та без stats не алокує
+    void collectInto(ArgentumDevice& device, const CollectOptions& options = CollectOptions(),
+                     CollectionStats* stats = nullptr, const std::function<bool()>& isCanceled = {}) const;
+
+    // ========================================
+    // Окремі проби
+    // ========================================
+    std::string osName() const;               // PRETTY_NAME з os-release
+    std::string kernelVersion() const;
+    std::string architecture() const;         // x86_64, arm64
+    std::string cpuModel() const;             // CPUID на x86, інакше /proc/cpuinfo; порожньо, якщо невідомо
+    uint32_t cpuCores() const;                // Доступні процесу логічні CPU
+    uint32_t cpuFrequencyMHz() const;         // CPUID 0x16, інакше cpufreq; 0, якщо невідомо
+    uint64_t totalRAM() const;                // Байти
+    uint64_t availableRAM() const;
+
+    std::optional<CgroupLimits> cgroupLimits() const;
+    std::optional<SystemPressure> pressure() const;
+    std::optional<SystemPressure> cgroupPressure() const;
+
+    std::vector<GPUInfo> gpuList() const;
+    std::vector<VolumeInfo> volumes(bool detectType) const;   // Без detectType не запускає lsblk
+    DiskType diskType(const std::string &device) const;       // /dev/sda1, nvme0n1
+    std::string blockDevice(const std::string &device) const; // /dev/mapper/vg-root -> dm-0
+    std::string diskTypeKey(const std::string &device) const; // /dev/nvme0n1p2 -> "disktype:nvme0n1"
+    std::vector<DiskIOStats> diskIOStats() const;
+    std::vector<NetInterfaceInfo> networkInterfaces() const;
+    std::vector<PowerDomainInfo> powerDomains() const;
+    std::vector<SensorReading> sensors() const;
+
+    // Варіанти для collectInto(): перевикористовують елементи та рядки out
+    bool cgroupLimitsInto(CgroupLimits& out) const;           // false - не cgroup v2
+    void diskIOStatsInto(std::vector<DiskIOStats>& out) const;
+    void networkInterfacesInto(std::vector<NetInterfaceInfo>& out) const;
+    void powerDomainsInto(std::vector<PowerDomainInfo>& out) const;
+
+    static uint32_t effectiveCPUCores(uint32_t hostCores, const std::optional<CgroupLimits>& limits);
+    static uint64_t effectiveRAM(uint64_t hostBytes, const std::optional<CgroupLimits>& limits);
+
+    // ========================================
+    // Кеш повільних джерел та hotplug
+    // ========================================
+    SourceCache& cache() const;               // Для джерел адаптера (WMI на Windows)
+    void invalidateCache(const std::string &prefix = std::string());  // "" - весь кеш і перелік томів
+    bool injectUevent(const std::string &message);
+    bool volumeTypesStale() const;            // Подія block ще не скинула типи дисків у переліку томів
+    bool sensorsStale() const;                // Подія hwmon/drm ще не перешукала сенсори
+
+    // Утиліта через ProcessRunner та кеш: ключ "cmd:<program> <args>"
+    bool runCachedCommand(const std::string &program, const std::vector<std::string> &arguments,
+                          int timeoutMs, std::chrono::milliseconds ttl, std::string &output) const;
+
+    // Утиліти інвентаря через runCachedCommand(): той самий ключ і TTL, що в gpuList(),
+    // тож поки працює hotplug-сокет, вивід живе до uevent, а не до короткого TTL
+    bool lspciOutput(std::string &output) const;                                // lspci -v
+    bool nvidiaSmiQuery(const std::string &fields, std::string &output) const;  // "memory.used"
+
+    static DiskType diskTypeFromString(const std::string &type);
+
+private:
+    // ОС, модель та максимальна частота CPU не змінюються під час роботи - читаються один раз
+    struct Identity {
+        std::string os;
+        std::string kernel;
+        std::string arch;
+        std::string cpuModel;
+        uint32_t cpuFrequencyMHz = 0;
+    };
+    const Identity& identity() const;
+
+    // Перелік томів під м'ютексом без копії: visit(const std::vector<VolumeInfo>&)
+    template <typename Visitor>
+    void visitVolumes(bool detectType, Visitor&& visit) const;
+
+    static bool runCommand(const std::string &program, const std::vector<std::string> &arguments,
+                           int timeoutMs, std::string &output);
+
+    // Дескриптори сенсорів відкриваються в конструкторі; hwmon/drm add/remove
+    // позначає перелік застарілим, і його перешукує наступне читання сенсорів
+    void refreshSensors() const;
+    std::unique_ptr<SensorCollector> m_sensors;
+    mutable std::atomic<bool> m_sensorsStale{ false };
+
+    // Виводи утиліт з TTL на кожне джерело
+    mutable SourceCache m_cache;
+
+    mutable std::once_flag m_identityOnce;
+    mutable Identity m_identity;
+
+#ifdef __linux__
+    std::optional<SystemPressure> readPressure(const char *directory, const char *suffix) const;
+    std::vector<VolumeInfo> enumerateVolumes(bool detectType) const;
+
+    // Сирі лічильники /proc/diskstats попередньої вибірки (для обчислення швидкостей)
+    struct DiskStatsCounters {
+        uint64_t reads, sectorsRead, readMs;
+        uint64_t writes, sectorsWritten, writeMs;
+        uint64_t ioMs, weightedMs;
+    };
+    struct DiskStatsEntry {
+        std::string name;
+        DiskStatsCounters counters;
+        bool seen;
+    };
+    mutable std::mutex m_diskStatsMutex;      // Захищає m_prevDiskStats*, m_diskStatsBuffer
+    mutable std::vector<DiskStatsEntry> m_prevDiskStats;
+    mutable std::chrono::steady_clock::time_point m_prevDiskStatsTime;
+    mutable std::string m_diskStatsBuffer;
+
+    // Лічильники /proc/net/dev попередньої вибірки; буфер файлу перевикористовується
+    struct NetDevCounters {
+        std::string name;
+        uint64_t rxBytes, rxPackets, rxErrors, rxDrops;
+        uint64_t txBytes, txPackets, txErrors, txDrops;
+        bool seen;
+    };
+    mutable std::mutex m_netDevMutex;         // Захищає m_prevNetDev*, m_netDevBuffer
+    mutable std::vector<NetDevCounters> m_prevNetDev;
+    mutable std::chrono::steady_clock::time_point m_prevNetDevTime;
+    mutable std::string m_netDevBuffer;
+
+    // Перелік томів перебудовується лише після POLLPRI на /proc/self/mountinfo;
+    // між змінами оновлюються тільки total/free/used через statvfs()
+    struct VolumeInventory {
+        std::vector<VolumeInfo> volumes;
+        bool typed = false;                       // Зібрано з detectType
+        bool valid = false;
+    };
+    mutable std::mutex m_volumesMutex;        // Захищає m_volumes, m_mountWatcher
+    mutable MountWatcher m_mountWatcher;
+    mutable VolumeInventory m_volumes;
+
+    // Hotplug block/pci/drm/hwmon: поки сокет працює, lspci та типи дисків не мають
+    // короткого TTL - їх інвалідують події. Черга вичитується перед читанням інвентаря
+    void pumpUevents() const;
+    void applyUevent(const Uevent &event) const;
+    std::chrono::milliseconds inventoryTtl(std::chrono::milliseconds fallback) const;
+    std::string diskName(const std::string &device) const;    // Цілий диск: blockDevice() або за ім'ям
+
+    mutable std::mutex m_ueventMutex;         // Серіалізує poll()/inject() монітора
+    std::unique_ptr<UeventMonitor> m_uevents;
+    mutable std::atomic<bool> m_volumeTypesStale{ false };   // Тип диска змінився - m_volumes.typed скидається
+
+    // Зони RAPL шукаються один раз (повторно - після invalidateCache("")),
+    // разом з energy_uj попередньої вибірки
+    struct PowerZone {
+        std::string zone;
+        std::string name;
+        uint64_t prevEnergy;
+        bool hasPrev;
+    };
+    mutable std::mutex m_energyMutex;         // Захищає m_powerZones*, m_prevEnergyTime
+    mutable std::vector<PowerZone> m_powerZones;
+    mutable bool m_powerZonesScanned = false;
+    mutable std::chrono::steady_clock::time_point m_prevEnergyTime;
+#endif
+};
+
+#endif // DEVICECOLLECTOR_H
@@ -0,0 +1,246 @@
+#ifndef DEVICEINFO_H
+#define DEVICEINFO_H
+
+#include <optional>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include "SensorCollector.h"
+
+// ========================================
+// Enum для типів дисків
+// ========================================
+enum class DiskType : uint8_t {
+    Unknown = 0,
+    HDD = 1,
+    SSD = 2,
+    External = 3,
+    Removable = 4
+};
+
+// ========================================
+// Статистика вводу/виводу блочного пристрою (/proc/diskstats)
+// ========================================
+struct DiskIOStats {
+    std::string device;                       // nvme0n1, sda, dm-0
+    uint64_t reads_completed = 0;             // Лічильники з моменту завантаження
+    uint64_t writes_completed = 0;
+    uint64_t read_bytes = 0;
+    uint64_t write_bytes = 0;
+    uint32_t in_flight = 0;                   // Запити в черзі прямо зараз
+
+    // Швидкості між двома вибірками (на першому виклику відсутні)
+    std::optional<double> read_mb_per_sec;    // MB/s читання
+    std::optional<double> write_mb_per_sec;   // MB/s запису
+    std::optional<double> read_iops;
+    std::optional<double> write_iops;
+    std::optional<double> await_ms;           // Середній час обслуговування запиту
+    std::optional<double> avg_queue_depth;    // Середня глибина черги (aqu-sz)
+    std::optional<double> util_percent;       // Частка часу з активним I/O (%util)
+};
+
+// ========================================
+// Структура для одного диску
+// ========================================
+struct DiskInfo {
+    std::string mount_point;     // C:/, E:/, F:/
+    std::string filesystem;      // NTFS, ext4
+    DiskType type;               // enum: SSD, HDD, External, Removable
+    uint64_t total_mb;           // Розмір в MB
+    uint64_t free_mb;            // Вільно в MB
+    uint64_t used_mb;            // Використано в MB
+    double usage_percent;        // Відсоток використання
+    double free_percent;         // Відсоток вільного місця
+    std::string block_device;    // nvme0n1 - фізичний диск, на якому лежить розділ
+    std::optional<DiskIOStats> io; // I/O фізичного диску (спільне для всіх його розділів)
+};
+
+// ========================================
+// Структура для одного мережевого інтерфейсу (/proc/net/dev)
+// ========================================
+struct NetInterfaceInfo {
+    std::string name;                          // eth0, enp5s0, wlan0
+    std::optional<uint32_t> speed_mbps;        // /sys/class/net/*/speed (немає для down/virtual)
+    std::optional<uint32_t> mtu;               // /sys/class/net/*/mtu
+
+    // Лічильники з моменту завантаження
+    uint64_t rx_bytes = 0;
+    uint64_t rx_packets = 0;
+    uint64_t rx_errors = 0;
+    uint64_t rx_drops = 0;
+    uint64_t tx_bytes = 0;
+    uint64_t tx_packets = 0;
+    uint64_t tx_errors = 0;
+    uint64_t tx_drops = 0;
+
+    // Швидкості між двома вибірками (на першому виклику відсутні)
+    std::optional<double> rx_mb_per_sec;
+    std::optional<double> tx_mb_per_sec;
+    std::optional<double> rx_packets_per_sec;
+    std::optional<double> tx_packets_per_sec;
+    std::optional<double> rx_errors_per_sec;
+    std::optional<double> tx_errors_per_sec;
+    std::optional<double> rx_drops_per_sec;
+    std::optional<double> tx_drops_per_sec;
+    std::optional<double> link_usage_percent; // max(rx, tx) відносно speed_mbps
+};
+
+// ========================================
+// Домен енергоспоживання RAPL (/sys/class/powercap/intel-rapl*)
+// ========================================
+struct PowerDomainInfo {
+    std::string zone;                 // intel-rapl:0, intel-rapl:0:2 (так само на AMD Zen)
+    std::string name;                 // package-0, core, uncore, dram, psys
+    uint64_t energy_uj = 0;           // Сирий лічильник energy_uj
+    std::optional<double> power_w;    // Середня потужність між вибірками (немає на першому виклику та при невідомому переповненні)
+};
+
+// ========================================
+// Структура для одного GPU
+// ========================================
+struct GPUInfo {
+    std::string model;                        // AMD Radeon RX 6600 XT
+    std::optional<uint64_t> vram_mb;          // Загальна VRAM в MB
+    std::optional<uint64_t> vram_used_mb;     // Використана VRAM в MB
+    std::optional<uint64_t> vram_free_mb;     // Вільна VRAM в MB
+    std::optional<double> vram_usage_percent; // Відсоток використання VRAM
+    std::string pci_address;                  // 0000:01:00.0 (Linux)
+    std::vector<SensorReading> sensors;       // hwmon цього GPU: температура, вентилятор, живлення
+};
+
+// ========================================
+// Ліміти cgroup v2 (для контейнерів)
+// ========================================
+struct CgroupLimits {
+    std::string path;                           // /sys/fs/cgroup/system.slice/app.service
+    std::optional<uint64_t> cpu_quota_us;       // cpu.max: квота (найжорсткіша по ієрархії)
+    std::optional<uint64_t> cpu_period_us;      // cpu.max: період
+    std::optional<double> cpu_quota_cores;      // квота / період, напр. 2.5 ядра
+    std::optional<uint32_t> cpuset_cpus;        // Кількість CPU у cpuset.cpus.effective
+    std::optional<uint64_t> memory_max_mb;      // memory.max (немає значення = "max")
+    std::optional<uint64_t> memory_high_mb;     // memory.high (немає значення = "max")
+    std::optional<uint64_t> memory_current_mb;  // memory.current
+};
+
+// ========================================
+// Pressure Stall Information (/proc/pressure/*)
+// ========================================
+struct PressureStats {
+    double avg10 = 0.0;      // % часу у стані stall за останні 10 s
+    double avg60 = 0.0;      // ... 60 s
+    double avg300 = 0.0;     // ... 300 s
+    uint64_t total_us = 0;   // Сумарний час stall з моменту завантаження
+};
+
+struct PressureInfo {
+    std::optional<PressureStats> some;   // Хоча б одна задача чекає на ресурс
+    std::optional<PressureStats> full;   // Всі задачі чекають (немає для cpu на старих ядрах)
+};
+
+struct SystemPressure {
+    std::optional<PressureInfo> cpu;
+    std::optional<PressureInfo> memory;
+    std::optional<PressureInfo> io;
+};
+
+// ========================================
+// Основна структура для Argentum
+// ========================================
+struct ArgentumDevice {
+    // OS
+    std::string os;                           // "Windows 11 Version 24H2"
+    std::optional<std::string> os_kernel;     // "10.0.26100"
+    std::optional<std::string> os_arch;       // "x86_64"
+    std::optional<std::string> platform;      // "Windows" або "Linux"
+    
+    // CPU
+    std::optional<std::string> cpu_model;     // "AMD Ryzen 7 5700X3D 8-Core Processor"
+    uint32_t cpu_cores;                       // 16
+    std::optional<uint32_t> cpu_frequency_mhz; // 3200
+    
+    // RAM
+    uint64_t ram_mb;                          // 32624 MB - загальна
+    std::optional<uint64_t> ram_used_mb;      // 11714 MB - використана
+    std::optional<uint64_t> ram_available_mb; // 20910 MB - доступна
+    std::optional<double> ram_usage_percent;  // 36.0%
+
+    // Ефективні ресурси з урахуванням cgroup v2 (поруч з host-значеннями вище)
+    std::optional<uint32_t> effective_cpu_cores; // min(cpu_cores, cpuset, ceil(квота))
+    std::optional<uint64_t> effective_ram_mb;    // min(ram_mb, memory.max, memory.high)
+    std::optional<CgroupLimits> cgroup;          // Сирі ліміти cgroup процесу
+
+    // Pressure Stall Information - чи справді робота чекає на CPU/RAM/I/O
+    std::optional<SystemPressure> pressure;        // /proc/pressure/*
+    std::optional<SystemPressure> cgroup_pressure; // <cgroup>/{cpu,memory,io}.pressure
+    
+    // GPU - ТІЛЬКИ СПИСОК
+    std::optional<uint32_t> gpu_count;        // 2 - кількість GPU
+    std::vector<GPUInfo> gpus;                // Список ВСІХ GPU з повною інфо
+    
+    // Диски
+    DiskType primary_disk_type;               // Тип основного диску (C:\ або /)
+    std::vector<DiskInfo> disks;              // Список ВСІХ дисків
+    std::optional<uint64_t> total_disk_mb;    // Загальний розмір всіх дисків
+    std::optional<uint64_t> free_disk_mb;     // Вільно на всіх дисках
+    std::optional<uint64_t> used_disk_mb;     // Використано на всіх дисків
+    std::optional<double> disk_usage_percent; // Відсоток використання дисків
+    std::vector<DiskIOStats> disk_io;         // I/O всіх фізичних блочних пристроїв
+
+    // Мережа
+    std::vector<NetInterfaceInfo> network;    // Всі мережеві інтерфейси
+
+    // Сенсори (hwmon + thermal zones)
+    std::vector<SensorReading> sensors;       // Температури, вентилятори, напруги, живлення
+
+    // Енергоспоживання (RAPL)
+    std::vector<PowerDomainInfo> power_domains; // package/core/dram/...
+    std::optional<double> package_power_w;      // Сума package-* доменів, W; немає, якщо хоч один без power_w
+    
+    // Конструктор
+    ArgentumDevice() 
+        : cpu_cores(0), 
+          ram_mb(0),
+          primary_disk_type(DiskType::Unknown) {}
+};
+
+// ========================================
+// Секції ArgentumDevice для вибіркового збору
+// ========================================
+enum class DeviceField : uint32_t {
+    OS = 1u << 0,           // os, os_kernel, os_arch, platform
+    CPU = 1u << 1,          // cpu_model, cpu_cores, cpu_frequency_mhz
+    RAM = 1u << 2,          // ram_*
+    Cgroup = 1u << 3,       // cgroup, effective_* (потребує CPU, RAM)
+    Pressure = 1u << 4,     // pressure, cgroup_pressure
+    GPU = 1u << 5,          // gpus, gpu_count; gpus[].sensors (потребує Sensors)
+    Sensors = 1u << 6,      // sensors
+    DiskSpace = 1u << 7,    // total/free/used_disk_mb, disk_usage_percent - без lsblk
+    Disks = 1u << 8,        // disks, primary_disk_type (потребує DiskSpace, DiskIO)
+    DiskIO = 1u << 9,       // disk_io
+    Network = 1u << 10,     // network
+    Power = 1u << 11,       // power_domains, package_power_w
+    All = (1u << 12) - 1
+};
+
+inline constexpr DeviceField operator|(DeviceField a, DeviceField b)
+{
+    return static_cast<DeviceField>(static_cast<uint32_t>(a) | static_cast<uint32_t>(b));
+}
+
+// ========================================
+// Параметри getDeviceInfo(options)
+// ========================================
+//
+// Запускаються лише проби запитаних секцій та їхніх залежностей; поля
+// незапитаних секцій лишаються порожніми (std::nullopt, "", 0).
+struct CollectOptions {
+    uint32_t fields = static_cast<uint32_t>(DeviceField::All);
+
+    CollectOptions() = default;
+    CollectOptions(DeviceField mask) : fields(static_cast<uint32_t>(mask)) {}
+
+    bool has(DeviceField field) const { return (fields & static_cast<uint32_t>(field)) != 0; }
+    CollectOptions resolved() const;    // + всі залежності запитаних секцій
+};
+
+#endif // DEVICEINFO_H
@@ -0,0 +1,219 @@
+#include "DiskFillForecaster.h"
+#include <algorithm>
+#include <cmath>
+
+// ========================================
+// DiskFillRule
+// ========================================
+
+DiskFillRule DiskFillRule::usageAbove(const std::string &name, double percent, double clearPercent)
+{
+    return { name, DiskFillCondition::UsageAbove, percent, std::min(clearPercent, percent), std::string() };
+}
+
+DiskFillRule DiskFillRule::timeToFullBelow(const std::string &name, std::chrono::seconds fire, std::chrono::seconds clear)
+{
+    const double fireSeconds = static_cast<double>(fire.count());
+    return { name, DiskFillCondition::TimeToFullBelow, fireSeconds,
+             std::max(static_cast<double>(clear.count()), fireSeconds), std::string() };
+}
+
+// ========================================
+// Конструктор та правила
+// ========================================
+
+DiskFillForecaster::DiskFillForecaster(const DiskFillOptions &options)
+    : m_options(options)
+{
+    if (m_options.half_life.count() <= 0)
+        m_options.half_life = std::chrono::seconds(1);
+    m_options.min_samples = std::max<uint32_t>(m_options.min_samples, 2);
+}
+
+void DiskFillForecaster::addRule(const DiskFillRule &rule)
+{
+    m_rules.push_back(rule);
+}
+
+const std::vector<DiskFillRule>& DiskFillForecaster::rules() const
+{
+    return m_rules;
+}
+
+// ========================================
+// Оновлення
+// ========================================
+
+void DiskFillForecaster::update(int64_t timestampMs, const std::vector<DiskInfo> &disks,
+                                std::vector<DiskFillAlert> &alerts)
+{
+    const double halfLife = static_cast<double>(m_options.half_life.count());
+
+    for (const DiskInfo& disk : disks) {
+        if (disk.total_mb == 0)
+            continue;
+
+        auto it = m_mounts.find(disk.mount_point);
+        if (it == m_mounts.end())
+            it = m_mounts.emplace(disk.mount_point, MountState()).first;
+        MountState& state = it->second;
+
+        if (state.samples > 0) {
+            if (timestampMs <= state.last_ms)
+                continue;
+
+            // Згасання та перенесення початку відліку часу на нову вибірку:
+            // t' = t - dt, тож нова вибірка лягає в t = 0
+            const double dt = (timestampMs - state.last_ms) / 1000.0;
+            const double decay = std::exp2(-dt / halfLife);
+            state.sum_w *= decay;
+            state.sum_t *= decay;
+            state.sum_y *= decay;
+            state.sum_tt *= decay;
+            state.sum_ty *= decay;
+
+            state.sum_tt += -2.0 * dt * state.sum_t + dt * dt * state.sum_w;
+            state.sum_ty -= dt * state.sum_y;
+            state.sum_t -= dt * state.sum_w;
+        }
+
+        const double y = static_cast<double>(disk.free_mb);
+        state.sum_w += 1.0;
+        state.sum_y += y;
+        // Нова вибірка в t = 0: внески в sum_t, sum_tt, sum_ty нульові
+
+        state.last_ms = timestampMs;
+        ++state.samples;
+        state.free_mb = disk.free_mb;
+        state.usage_percent = disk.usage_percent;
+
+        evaluate(disk.mount_point, state, alerts);
+    }
+
+    // Точки монтування, що зникли: знімаємо їхні сповіщення
+    const int64_t forgetMs = std::chrono::duration_cast<std::chrono::milliseconds>(m_options.forget_after).count();
+    for (auto it = m_mounts.begin(); it != m_mounts.end(); ) {
+        MountState& state = it->second;
+        if (timestampMs - state.last_ms <= forgetMs) {
+            ++it;
+            continue;
+        }
+        for (size_t i = 0; i < state.firing.size(); ++i) {
+            if (!state.firing[i])
+                continue;
+            DiskFillAlert alert;
+            alert.rule = m_rules[i].name;
+            alert.mount_point = it->first;
+            alert.firing = false;
+            alert.usage_percent = state.usage_percent;
+            alerts.push_back(std::move(alert));
+        }
+        it = m_mounts.erase(it);
+    }
+}
+
+std::optional<double> DiskFillForecaster::slopePerSecond(const MountState &state)
+{
+    const double denominator = state.sum_w * state.sum_tt - state.sum_t * state.sum_t;
+    // Усі вибірки фактично в одній точці часу
+    if (!(denominator > 1e-9 * state.sum_w * state.sum_w))
+        return std::nullopt;
+    return (state.sum_w * state.sum_ty - state.sum_t * state.sum_y) / denominator;
+}
+
+DiskFillForecast DiskFillForecaster::makeForecast(const std::string &mountPoint, const MountState &state) const
+{
+    DiskFillForecast forecast;
+    forecast.mount_point = mountPoint;
+    forecast.free_mb = state.free_mb;
+    forecast.usage_percent = state.usage_percent;
+    forecast.samples = state.samples;
+    if (state.samples < m_options.min_samples)
+        return forecast;
+
+    const std::optional<double> slope = slopePerSecond(state);
+    if (!slope.has_value())
+        return forecast;
+
+    forecast.free_mb_per_hour = slope.value() * 3600.0;
+    if (slope.value() < 0.0) {
+        const double seconds = static_cast<double>(state.free_mb) / -slope.value();
+        // Практично нескінченність - не переповнюємо std::chrono::seconds
+        if (seconds < 1e15)
+            forecast.time_to_full = std::chrono::seconds(static_cast<int64_t>(seconds));
+    }
+    return forecast;
+}
+
+void DiskFillForecaster::evaluate(const std::string &mountPoint, MountState &state, std::vector<DiskFillAlert> &alerts)
+{
+    if (m_rules.empty())
+        return;
+    state.firing.resize(m_rules.size(), 0);
+
+    const DiskFillForecast forecast = makeForecast(mountPoint, state);
+    for (size_t i = 0; i < m_rules.size(); ++i) {
+        const DiskFillRule& rule = m_rules[i];
+        if (!rule.mount_point.empty() && rule.mount_point != mountPoint)
+            continue;
+
+        const bool firing = state.firing[i] != 0;
+        bool next = firing;
+        if (rule.condition == DiskFillCondition::UsageAbove) {
+            next = firing ? forecast.usage_percent >= rule.clear : forecast.usage_percent >= rule.fire;
+        } else if (forecast.time_to_full.has_value()) {
+            const double seconds = static_cast<double>(forecast.time_to_full->count());
+            next = firing ? seconds <= rule.clear : seconds <= rule.fire;
+        } else if (forecast.free_mb_per_hour.has_value()) {
+            // Тренд є, але диск не заповнюється
+            next = false;
+        }
+
+        if (next == firing)
+            continue;
+        state.firing[i] = next ? 1 : 0;
+
+        DiskFillAlert alert;
+        alert.rule = rule.name;
+        alert.mount_point = mountPoint;
+        alert.firing = next;
+        alert.usage_percent = forecast.usage_percent;
+        alert.time_to_full = forecast.time_to_full;
+        alerts.push_back(std::move(alert));
+    }
+}
+
+// ========================================
+// Запити
+// ========================================
+
+std::optional<DiskFillForecast> DiskFillForecaster::forecast(const std::string &mountPoint) const
+{
+    auto it = m_mounts.find(mountPoint);
+    if (it == m_mounts.end())
+        return std::nullopt;
+    return makeForecast(it->first, it->second);
+}
+
+std::vector<DiskFillForecast> DiskFillForecaster::forecasts() const
+{
+    std::vector<DiskFillForecast> result;
+    result.reserve(m_mounts.size());
+    for (const auto& entry : m_mounts)
+        result.push_back(makeForecast(entry.first, entry.second));
+    std::sort(result.begin(), result.end(),
+              [](const DiskFillForecast& a, const DiskFillForecast& b) { return a.mount_point < b.mount_point; });
+    return result;
+}
+
+bool DiskFillForecaster::isFiring(const std::string &rule, const std::string &mountPoint) const
+{
+    auto it = m_mounts.find(mountPoint);
+    if (it == m_mounts.end())
+        return false;
+    for (size_t i = 0; i < m_rules.size() && i < it->second.firing.size(); ++i) {
+        if (m_rules[i].name == rule && it->second.firing[i])
+            return true;
+    }
+    return false;
+}
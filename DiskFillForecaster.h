@@ -0,0 +1,125 @@
+#ifndef DISKFILLFORECASTER_H
+#define DISKFILLFORECASTER_H
+
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "DeviceInfo.h"
+
+// ========================================
+// Параметри DiskFillForecaster
+// ========================================
+struct DiskFillOptions {
+    std::chrono::seconds half_life = std::chrono::hours(1);        // Вага вибірки падає вдвічі за цей час
+    uint32_t min_samples = 5;                                      // До цього тренд та ETA не оцінюються
+    std::chrono::seconds forget_after = std::chrono::minutes(10);  // Точка монтування зникла з вибірок
+};
+
+// ========================================
+// Правило сповіщення
+// ========================================
+enum class DiskFillCondition {
+    UsageAbove,          // usage_percent >= fire; знімається при < clear
+    TimeToFullBelow      // time_to_full <= fire секунд; знімається при > clear або без заповнення
+};
+
+struct DiskFillRule {
+    std::string name;                    // "disk-6h", "disk-90pct"
+    DiskFillCondition condition;
+    double fire;                         // Поріг спрацювання: % або секунди
+    double clear;                        // Поріг зняття (гістерезис)
+    std::string mount_point;             // Порожній - усі точки монтування
+
+    static DiskFillRule usageAbove(const std::string &name, double percent, double clearPercent);
+    static DiskFillRule timeToFullBelow(const std::string &name, std::chrono::seconds fire, std::chrono::seconds clear);
+};
+
+// ========================================
+// Оцінка для однієї точки монтування
+// ========================================
+struct DiskFillForecast {
+    std::string mount_point;
+    uint64_t free_mb = 0;                           // З останньої вибірки
+    double usage_percent = 0.0;
+    uint32_t samples = 0;
+    std::optional<double> free_mb_per_hour;         // Тренд; від'ємний - диск заповнюється
+    std::optional<std::chrono::seconds> time_to_full;   // Лише коли диск заповнюється
+};
+
+// ========================================
+// Зміна стану правила
+// ========================================
+struct DiskFillAlert {
+    std::string rule;
+    std::string mount_point;
+    bool firing = false;                            // true - спрацювало, false - знято
+    double usage_percent = 0.0;
+    std::optional<std::chrono::seconds> time_to_full;
+};
+
+// ========================================
+// Клас DiskFillForecaster - прогноз заповнення дисків та сповіщення
+// ========================================
+//
+// Для кожної точки монтування - експоненційно зважена лінійна регресія
+// free_mb від часу: п'ять зважених сум, що згасають з half_life. Суми
+// зберігаються відносно часу останньої вибірки, тож не втрачають точності
+// з часом; оновлення - O(1) на точку монтування без історії.
+//
+// time_to_full = free_mb / -нахил, якщо нахил від'ємний. Правило спрацьовує
+// при перетині fire і знімається лише після перетину clear - значення,
+// що коливається біля порогу, не дає потоку сповіщень.
+//
+//     DiskFillForecaster forecaster;
+//     forecaster.addRule(DiskFillRule::timeToFullBelow("disk-6h", 6h, 12h));
+//     forecaster.addRule(DiskFillRule::usageAbove("disk-90pct", 90.0, 85.0));
+//     ...
+//     alerts.clear();
+//     forecaster.update(nowMs, device.disks, alerts);
+//
+// Не потокобезпечний - живе в циклі вибірок.
+class DiskFillForecaster
+{
+public:
+    explicit DiskFillForecaster(const DiskFillOptions &options = DiskFillOptions());
+
+    void addRule(const DiskFillRule &rule);
+    const std::vector<DiskFillRule>& rules() const;
+
+    // Дописує в alerts переходи правил; вибірки з міткою не новішою за
+    // попередню для точки монтування пропускаються
+    void update(int64_t timestampMs, const std::vector<DiskInfo> &disks, std::vector<DiskFillAlert> &alerts);
+
+    std::optional<DiskFillForecast> forecast(const std::string &mountPoint) const;
+    std::vector<DiskFillForecast> forecasts() const;
+    bool isFiring(const std::string &rule, const std::string &mountPoint) const;
+
+private:
+    struct MountState {
+        // Зважені суми; час - секунди відносно last_ms
+        double sum_w = 0.0;
+        double sum_t = 0.0;
+        double sum_y = 0.0;
+        double sum_tt = 0.0;
+        double sum_ty = 0.0;
+
+        int64_t last_ms = 0;
+        uint32_t samples = 0;
+        uint64_t free_mb = 0;
+        double usage_percent = 0.0;
+        std::vector<uint8_t> firing;             // За номером правила
+    };
+
+    static std::optional<double> slopePerSecond(const MountState &state);
+    DiskFillForecast makeForecast(const std::string &mountPoint, const MountState &state) const;
+    void evaluate(const std::string &mountPoint, MountState &state, std::vector<DiskFillAlert> &alerts);
+
+    DiskFillOptions m_options;
+    std::vector<DiskFillRule> m_rules;
+    std::unordered_map<std::string, MountState> m_mounts;
+};
+
+#endif // DISKFILLFORECASTER_H
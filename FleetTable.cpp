@@ -0,0 +1,368 @@
+#include "FleetTable.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+
+namespace {
+
+const double kMissing = std::numeric_limits<double>::quiet_NaN();
+
+template <typename T>
+double optionalValue(const std::optional<T>& value)
+{
+    return value.has_value() ? static_cast<double>(value.value()) : kMissing;
+}
+
+// cpu_cores та ram_mb не optional: 0 означає, що секцію не зібрано
+double nonZeroValue(uint64_t value)
+{
+    return value > 0 ? static_cast<double>(value) : kMissing;
+}
+
+std::string_view optionalView(const std::optional<std::string>& value)
+{
+    return value.has_value() ? std::string_view(value.value()) : std::string_view();
+}
+
+double someAvg10(const std::optional<SystemPressure>& pressure, std::optional<PressureInfo> SystemPressure::*resource)
+{
+    if (!pressure.has_value()) return kMissing;
+    const std::optional<PressureInfo>& info = pressure.value().*resource;
+    if (!info.has_value() || !info->some.has_value()) return kMissing;
+    return info->some->avg10;
+}
+
+// Рядки, які може вибрати mask: як у filter*, рядки поза коротшою маскою не вибрані
+size_t maskedRows(size_t rows, const FleetTable::Mask* mask)
+{
+    return mask == nullptr ? rows : std::min(rows, mask->size());
+}
+
+// Лише для row < maskedRows()
+bool isSelected(const FleetTable::Mask* mask, size_t row)
+{
+    return mask == nullptr || (*mask)[row] != 0;
+}
+
+// Вибрані значення без NaN у out; компактизація без розгалужень
+void gatherSelected(const std::vector<double>& column, const FleetTable::Mask* mask, std::vector<double>& out)
+{
+    const size_t rows = maskedRows(column.size(), mask);
+    out.resize(rows);
+    size_t count = 0;
+    if (mask == nullptr) {
+        for (size_t i = 0; i < rows; ++i) {
+            double value = column[i];
+            out[count] = value;
+            count += static_cast<size_t>(!std::isnan(value));
+        }
+    }
+    else {
+        const uint8_t* selected = mask->data();
+        for (size_t i = 0; i < rows; ++i) {
+            double value = column[i];
+            out[count] = value;
+            count += static_cast<size_t>(selected[i] & static_cast<uint8_t>(!std::isnan(value)));
+        }
+    }
+    out.resize(count);
+}
+
+// Квантилі над [begin, end) з лінійною інтерполяцією (як numpy за замовчуванням).
+// Порядок елементів змінюється: кожен nth_element звужує діапазон для наступного q
+void quantilesInPlace(double* begin, double* end, const std::vector<double>& q, std::vector<double>& out)
+{
+    out.assign(q.size(), kMissing);
+    const size_t n = static_cast<size_t>(end - begin);
+    if (n == 0)
+        return;
+
+    std::vector<size_t> order(q.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&q](size_t a, size_t b) { return q[a] < q[b]; });
+
+    size_t placedFrom = 0;          // [0, placedFrom) уже на своїх позиціях
+    for (size_t index : order) {
+        double rank = std::min(std::max(q[index], 0.0), 1.0) * static_cast<double>(n - 1);
+        size_t k = static_cast<size_t>(rank);
+        double fraction = rank - static_cast<double>(k);
+
+        if (k >= placedFrom) {
+            std::nth_element(begin + placedFrom, begin + k, end);
+            placedFrom = k + 1;
+        }
+        double value = begin[k];
+        if (fraction > 0.0 && k + 1 < n) {
+            double next = *std::min_element(begin + k + 1, end);
+            value += fraction * (next - value);
+        }
+        out[index] = value;
+    }
+}
+
+template <typename Key>
+std::vector<FleetTable::GroupStats> groupByKey(const std::vector<Key>& keys, const std::vector<double>& values,
+                                               const FleetTable::Mask* mask, const std::vector<double>& q)
+{
+    std::vector<FleetTable::GroupStats> groups;
+    const size_t rows = maskedRows(std::min(keys.size(), values.size()), mask);
+    if (rows == 0)
+        return groups;
+
+    // Сортування підрахунком: значення кожного ключа - неперервний відрізок grouped
+    const uint32_t keyCount = static_cast<uint32_t>(*std::max_element(keys.begin(), keys.begin() + rows)) + 1;
+    std::vector<uint32_t> offsets(static_cast<size_t>(keyCount) + 1, 0);
+    for (size_t i = 0; i < rows; ++i) {
+        offsets[static_cast<size_t>(keys[i]) + 1] += static_cast<uint32_t>(isSelected(mask, i) && !std::isnan(values[i]));
+    }
+    for (size_t key = 1; key < offsets.size(); ++key) {
+        offsets[key] += offsets[key - 1];
+    }
+
+    std::vector<double> grouped(offsets.back());
+    std::vector<uint32_t> cursor(offsets.begin(), offsets.end() - 1);
+    for (size_t i = 0; i < rows; ++i) {
+        if (isSelected(mask, i) && !std::isnan(values[i]))
+            grouped[cursor[keys[i]]++] = values[i];
+    }
+
+    for (uint32_t key = 0; key < keyCount; ++key) {
+        double* begin = grouped.data() + offsets[key];
+        double* end = grouped.data() + offsets[key + 1];
+        if (begin == end)
+            continue;
+
+        FleetTable::GroupStats group;
+        group.key = key;
+        group.count = static_cast<uint64_t>(end - begin);
+        group.min = *begin;
+        group.max = *begin;
+        for (const double* value = begin; value != end; ++value) {
+            group.sum += *value;
+            group.min = std::min(group.min, *value);
+            group.max = std::max(group.max, *value);
+        }
+        if (!q.empty())
+            quantilesInPlace(begin, end, q, group.quantiles);
+        groups.push_back(std::move(group));
+    }
+    return groups;
+}
+
+template <typename T>
+void filterEqualsImpl(const std::vector<T>& column, T value, FleetTable::Mask& mask)
+{
+    const size_t rows = std::min(column.size(), mask.size());
+    uint8_t* selected = mask.data();
+    for (size_t i = 0; i < rows; ++i) {
+        selected[i] &= static_cast<uint8_t>(column[i] == value);
+    }
+}
+
+} // namespace
+
+// ========================================
+// StringDictionary
+// ========================================
+
+uint32_t StringDictionary::intern(std::string_view value)
+{
+    auto inserted = m_codes.emplace(std::string(value), static_cast<uint32_t>(m_values.size()));
+    if (inserted.second)
+        m_values.emplace_back(value);
+    return inserted.first->second;
+}
+
+uint32_t StringDictionary::find(std::string_view value) const
+{
+    auto it = m_codes.find(std::string(value));
+    return it != m_codes.end() ? it->second : kNoCode;
+}
+
+const std::string& StringDictionary::value(uint32_t code) const
+{
+    return m_values.at(code);
+}
+
+size_t StringDictionary::size() const
+{
+    return m_values.size();
+}
+
+void StringDictionary::clear()
+{
+    m_codes.clear();
+    m_values.clear();
+}
+
+// ========================================
+// Завантаження знімків
+// ========================================
+
+uint32_t FleetTable::append(const ArgentumDevice& device)
+{
+    const uint32_t row = static_cast<uint32_t>(m_hosts.os.size());
+
+    m_hosts.os.push_back(m_strings.intern(device.os));
+    m_hosts.cpu_model.push_back(m_strings.intern(optionalView(device.cpu_model)));
+    m_hosts.cpu_cores.push_back(nonZeroValue(device.cpu_cores));
+    m_hosts.effective_cpu_cores.push_back(optionalValue(device.effective_cpu_cores));
+    m_hosts.ram_mb.push_back(nonZeroValue(device.ram_mb));
+    m_hosts.effective_ram_mb.push_back(optionalValue(device.effective_ram_mb));
+    m_hosts.ram_usage_percent.push_back(optionalValue(device.ram_usage_percent));
+    m_hosts.total_disk_mb.push_back(optionalValue(device.total_disk_mb));
+    m_hosts.free_disk_mb.push_back(optionalValue(device.free_disk_mb));
+    m_hosts.disk_usage_percent.push_back(optionalValue(device.disk_usage_percent));
+    m_hosts.primary_disk_type.push_back(static_cast<uint8_t>(device.primary_disk_type));
+    m_hosts.gpu_count.push_back(optionalValue(device.gpu_count));
+    m_hosts.package_power_w.push_back(optionalValue(device.package_power_w));
+    m_hosts.cpu_pressure_avg10.push_back(someAvg10(device.pressure, &SystemPressure::cpu));
+    m_hosts.memory_pressure_avg10.push_back(someAvg10(device.pressure, &SystemPressure::memory));
+
+    for (const DiskInfo& disk : device.disks) {
+        m_disks.host.push_back(row);
+        m_disks.type.push_back(static_cast<uint8_t>(disk.type));
+        m_disks.filesystem.push_back(m_strings.intern(disk.filesystem));
+        m_disks.total_mb.push_back(static_cast<double>(disk.total_mb));
+        m_disks.free_mb.push_back(static_cast<double>(disk.free_mb));
+        m_disks.usage_percent.push_back(disk.usage_percent);
+    }
+
+    for (const GPUInfo& gpu : device.gpus) {
+        m_gpus.host.push_back(row);
+        m_gpus.model.push_back(m_strings.intern(gpu.model));
+        m_gpus.vram_mb.push_back(optionalValue(gpu.vram_mb));
+        m_gpus.vram_used_mb.push_back(optionalValue(gpu.vram_used_mb));
+        m_gpus.vram_free_mb.push_back(optionalValue(gpu.vram_free_mb));
+        m_gpus.vram_usage_percent.push_back(optionalValue(gpu.vram_usage_percent));
+    }
+
+    return row;
+}
+
+void FleetTable::reserve(size_t hosts)
+{
+    for (std::vector<uint32_t>* column : { &m_hosts.os, &m_hosts.cpu_model }) {
+        column->reserve(hosts);
+    }
+    for (std::vector<double>* column : { &m_hosts.cpu_cores, &m_hosts.effective_cpu_cores, &m_hosts.ram_mb,
+                                         &m_hosts.effective_ram_mb, &m_hosts.ram_usage_percent,
+                                         &m_hosts.total_disk_mb, &m_hosts.free_disk_mb,
+                                         &m_hosts.disk_usage_percent, &m_hosts.gpu_count,
+                                         &m_hosts.package_power_w, &m_hosts.cpu_pressure_avg10,
+                                         &m_hosts.memory_pressure_avg10 }) {
+        column->reserve(hosts);
+    }
+    m_hosts.primary_disk_type.reserve(hosts);
+}
+
+void FleetTable::clear()
+{
+    m_hosts = HostColumns();
+    m_disks = DiskColumns();
+    m_gpus = GpuColumns();
+    m_strings.clear();
+}
+
+size_t FleetTable::hostCount() const
+{
+    return m_hosts.os.size();
+}
+
+size_t FleetTable::diskCount() const
+{
+    return m_disks.host.size();
+}
+
+size_t FleetTable::gpuCount() const
+{
+    return m_gpus.host.size();
+}
+
+const FleetTable::HostColumns& FleetTable::hosts() const
+{
+    return m_hosts;
+}
+
+const FleetTable::DiskColumns& FleetTable::disks() const
+{
+    return m_disks;
+}
+
+const FleetTable::GpuColumns& FleetTable::gpus() const
+{
+    return m_gpus;
+}
+
+const StringDictionary& FleetTable::strings() const
+{
+    return m_strings;
+}
+
+// ========================================
+// Фільтри
+// ========================================
+
+FleetTable::Mask FleetTable::selectAll(size_t rows)
+{
+    return Mask(rows, 1);
+}
+
+void FleetTable::filterRange(const std::vector<double>& column, double min, double max, Mask& mask)
+{
+    const size_t rows = std::min(column.size(), mask.size());
+    const double* values = column.data();
+    uint8_t* selected = mask.data();
+    for (size_t i = 0; i < rows; ++i) {
+        selected[i] &= static_cast<uint8_t>((values[i] >= min) & (values[i] <= max));
+    }
+}
+
+void FleetTable::filterEquals(const std::vector<uint32_t>& column, uint32_t value, Mask& mask)
+{
+    filterEqualsImpl(column, value, mask);
+}
+
+void FleetTable::filterEquals(const std::vector<uint8_t>& column, uint8_t value, Mask& mask)
+{
+    filterEqualsImpl(column, value, mask);
+}
+
+FleetTable::Mask FleetTable::selectByHost(const std::vector<uint32_t>& host, const Mask& hostMask)
+{
+    Mask mask(host.size());
+    for (size_t i = 0; i < host.size(); ++i) {
+        mask[i] = host[i] < hostMask.size() ? hostMask[host[i]] : 0;
+    }
+    return mask;
+}
+
+// ========================================
+// Агрегати
+// ========================================
+
+std::vector<double> FleetTable::quantiles(const std::vector<double>& column, const Mask* mask,
+                                          const std::vector<double>& q)
+{
+    std::vector<double> values;
+    gatherSelected(column, mask, values);
+
+    std::vector<double> result;
+    quantilesInPlace(values.data(), values.data() + values.size(), q, result);
+    return result;
+}
+
+std::vector<FleetTable::GroupStats> FleetTable::groupBy(const std::vector<uint32_t>& keys,
+                                                        const std::vector<double>& values,
+                                                        const Mask* mask, const std::vector<double>& q)
+{
+    return groupByKey(keys, values, mask, q);
+}
+
+std::vector<FleetTable::GroupStats> FleetTable::groupBy(const std::vector<uint8_t>& keys,
+                                                        const std::vector<double>& values,
+                                                        const Mask* mask, const std::vector<double>& q)
+{
+    return groupByKey(keys, values, mask, q);
+}
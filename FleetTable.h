@@ -0,0 +1,145 @@
+#ifndef FLEETTABLE_H
+#define FLEETTABLE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "DeviceInfo.h"
+
+// ========================================
+// Словник рядків: рядок -> щільний код 0..size()-1
+// ========================================
+class StringDictionary
+{
+public:
+    static constexpr uint32_t kNoCode = UINT32_MAX;
+
+    uint32_t intern(std::string_view value);
+    uint32_t find(std::string_view value) const;      // kNoCode, якщо рядка немає
+    const std::string& value(uint32_t code) const;
+    size_t size() const;
+    void clear();
+
+private:
+    std::unordered_map<std::string, uint32_t> m_codes;
+    std::vector<std::string> m_values;
+};
+
+// ========================================
+// Клас FleetTable - знімки ArgentumDevice багатьох хостів у колонках
+// ========================================
+//
+// Struct-of-arrays: кожне поле - окремий неперервний std::vector, рядки
+// (os, cpu_model, gpu.model, filesystem) закодовані через один словник.
+// Три таблиці: hosts (рядок на знімок), disks та gpus (рядок на диск/GPU
+// з індексом хоста). Відсутні значення std::optional - NaN.
+//
+// Ядра працюють над колонками та маскою рядків (1 - рядок вибрано) без
+// розгалужень у внутрішніх циклах, тож компілятор векторизує їх:
+// filter* звужують маску, quantiles() та groupBy() рахують по вибраних.
+// Не потокобезпечний на запис; читання з кількох потоків - без append().
+class FleetTable
+{
+public:
+    using Mask = std::vector<uint8_t>;
+
+    struct HostColumns {
+        std::vector<uint32_t> os;                     // Код рядка
+        std::vector<uint32_t> cpu_model;              // Код рядка
+        std::vector<double> cpu_cores;
+        std::vector<double> effective_cpu_cores;
+        std::vector<double> ram_mb;
+        std::vector<double> effective_ram_mb;
+        std::vector<double> ram_usage_percent;
+        std::vector<double> total_disk_mb;
+        std::vector<double> free_disk_mb;
+        std::vector<double> disk_usage_percent;
+        std::vector<uint8_t> primary_disk_type;       // DiskType
+        std::vector<double> gpu_count;
+        std::vector<double> package_power_w;
+        std::vector<double> cpu_pressure_avg10;       // pressure.cpu.some.avg10
+        std::vector<double> memory_pressure_avg10;    // pressure.memory.some.avg10
+    };
+
+    struct DiskColumns {
+        std::vector<uint32_t> host;                   // Рядок у HostColumns
+        std::vector<uint8_t> type;                    // DiskType
+        std::vector<uint32_t> filesystem;             // Код рядка
+        std::vector<double> total_mb;
+        std::vector<double> free_mb;
+        std::vector<double> usage_percent;
+    };
+
+    struct GpuColumns {
+        std::vector<uint32_t> host;
+        std::vector<uint32_t> model;                  // Код рядка
+        std::vector<double> vram_mb;
+        std::vector<double> vram_used_mb;
+        std::vector<double> vram_free_mb;             // Запас VRAM
+        std::vector<double> vram_usage_percent;
+    };
+
+    // Агрегати однієї групи groupBy()
+    struct GroupStats {
+        uint32_t key = 0;                             // Код рядка або значення enum
+        uint64_t count = 0;                           // Вибрані рядки без NaN
+        double sum = 0.0;
+        double min = 0.0;
+        double max = 0.0;
+        std::vector<double> quantiles;                // У порядку запитаних q
+
+        double mean() const { return count > 0 ? sum / count : 0.0; }
+    };
+
+    // ========================================
+    // Завантаження
+    // ========================================
+    uint32_t append(const ArgentumDevice& device);    // Номер рядка хоста
+    void reserve(size_t hosts);
+    void clear();
+
+    size_t hostCount() const;
+    size_t diskCount() const;
+    size_t gpuCount() const;
+
+    const HostColumns& hosts() const;
+    const DiskColumns& disks() const;
+    const GpuColumns& gpus() const;
+    const StringDictionary& strings() const;
+
+    // ========================================
+    // Ядра
+    // ========================================
+    static Mask selectAll(size_t rows);
+
+    // Звужують mask (логічне І); NaN не проходить жоден фільтр
+    static void filterRange(const std::vector<double>& column, double min, double max, Mask& mask);
+    static void filterEquals(const std::vector<uint32_t>& column, uint32_t value, Mask& mask);
+    static void filterEquals(const std::vector<uint8_t>& column, uint8_t value, Mask& mask);
+
+    // Маска дочірньої таблиці (disks/gpus) за маскою хостів
+    static Mask selectByHost(const std::vector<uint32_t>& host, const Mask& hostMask);
+
+    // Квантилі q з [0, 1] з лінійною інтерполяцією; NaN, якщо нічого не вибрано.
+    // mask == nullptr - усі рядки; рядки за кінцем коротшої mask не вибрані (як у filter*)
+    static std::vector<double> quantiles(const std::vector<double>& column, const Mask* mask,
+                                         const std::vector<double>& q);
+
+    // Групи за ключем (код словника або DiskType) у порядку зростання ключа;
+    // групи без жодного вибраного значення пропускаються
+    static std::vector<GroupStats> groupBy(const std::vector<uint32_t>& keys, const std::vector<double>& values,
+                                           const Mask* mask, const std::vector<double>& q = {});
+    static std::vector<GroupStats> groupBy(const std::vector<uint8_t>& keys, const std::vector<double>& values,
+                                           const Mask* mask, const std::vector<double>& q = {});
+
+private:
+    HostColumns m_hosts;
+    DiskColumns m_disks;
+    GpuColumns m_gpus;
+    StringDictionary m_strings;
+};
+
+#endif // FLEETTABLE_H
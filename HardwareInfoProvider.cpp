@@ -6,9 +6,15 @@
 #include <QTextStream>
 #include <QStorageInfo>
 #include <QDir>
+#include <QThreadPool>
+#include <QPromise>
+#include <QtConcurrent>
 #include <string>
 #include <iostream>
 #include <iomanip>
+#include <algorithm>
+#include <cmath>
+#include <mutex>
 
 // Platform-specific includes
 #ifdef _WIN32
@@ -25,24 +31,48 @@
 #endif
 
 #ifdef __linux__
-#include <sys/sysinfo.h>
-#include <unistd.h>
-#include <QProcess>
-#include <QDir>
 #include <QRegularExpression>
-#include <fstream>
 #endif
 
+// ========================================
+// Стан асинхронного збору
+// ========================================
+
+struct HardwareInfoProvider::AsyncState {
+    QThreadPool pool;                   // Один потік: збори виконуються послідовно
+    std::mutex mutex;
+    QFuture<ArgentumDevice> inflight;
+    uint32_t inflightFields = 0;
+    std::vector<QFuture<ArgentumDevice>> queued;   // Усі незавершені збори, не лише останній
+};
+
+namespace {
+
+// Скільки живе вивід джерела в SourceCache (lspci та nvidia-smi - TTL DeviceCollector)
+const std::chrono::milliseconds kWmiDiskTypeTtl = std::chrono::minutes(5);
+
+} // namespace
+
 // ========================================
 // Конструктор та деструктор
 // ========================================
 
 HardwareInfoProvider::HardwareInfoProvider()
+    : m_async(std::make_unique<AsyncState>())
 {
+    m_async->pool.setMaxThreadCount(1);
 }
 
 HardwareInfoProvider::~HardwareInfoProvider()
 {
+    {
+        // Скасований збір у черзі пула не стартує, а той, що виконується, перериває
+        // наступну пробу - waitForDone() не чекає на збори, результат яких нікому не потрібен
+        std::lock_guard<std::mutex> lock(m_async->mutex);
+        for (QFuture<ArgentumDevice>& future : m_async->queued)
+            future.cancel();
+    }
+    m_async->pool.waitForDone();
 }
 
 // ========================================
@@ -51,17 +81,29 @@ HardwareInfoProvider::~HardwareInfoProvider()
 
 QString HardwareInfoProvider::getOSInfo() const
 {
+#ifdef __linux__
+    return QString::fromStdString(m_core.osName());
+#else
     return QSysInfo::prettyProductName();
+#endif
 }
 
 QString HardwareInfoProvider::getKernelVersion() const
 {
+#ifdef __linux__
+    return QString::fromStdString(m_core.kernelVersion());
+#else
     return QSysInfo::kernelVersion();
+#endif
 }
 
 QString HardwareInfoProvider::getArchitecture() const
 {
+#ifdef __linux__
+    return QString::fromStdString(m_core.architecture());
+#else
     return QSysInfo::currentCpuArchitecture();
+#endif
 }
 
 QString HardwareInfoProvider::getPlatformName() const
@@ -119,30 +161,6 @@ int HardwareInfoProvider::getCPUFrequencyFromRegistry() const
 }
 #endif
 
-// ========================================
-// Інформація про CPU - Linux
-// ========================================
-
-#ifdef __linux__
-QString HardwareInfoProvider::getLinuxCPUInfo() const
-{
-    QFile cpuInfo("/proc/cpuinfo");
-    if (cpuInfo.open(QIODevice::ReadOnly)) {
-        QTextStream stream(&cpuInfo);
-        QString line;
-        while (stream.readLineInto(&line)) {
-            if (line.startsWith("model name")) {
-                QStringList parts = line.split(":");
-                if (parts.size() >= 2) {
-                    return parts[1].trimmed();
-                }
-            }
-        }
-    }
-    return "Unknown CPU";
-}
-#endif
-
 // ========================================
 // Інформація про CPU - Загальні методи
 // ========================================
@@ -152,7 +170,8 @@ QString HardwareInfoProvider::getCPUName() const
 #ifdef _WIN32
     return getCPUNameFromRegistry();
 #elif defined(__linux__)
-    return getLinuxCPUInfo();
+    std::string model = m_core.cpuModel();
+    return model.empty() ? QString("Unknown CPU") : QString::fromStdString(model);
 #else
     return "Unknown CPU";
 #endif
@@ -160,7 +179,11 @@ QString HardwareInfoProvider::getCPUName() const
 
 int HardwareInfoProvider::getCPUCores() const
 {
+#ifdef __linux__
+    return static_cast<int>(m_core.cpuCores());
+#else
     return QThread::idealThreadCount();
+#endif
 }
 
 int HardwareInfoProvider::getCPUFrequencyMHz() const
@@ -168,12 +191,7 @@ int HardwareInfoProvider::getCPUFrequencyMHz() const
 #ifdef _WIN32
     return getCPUFrequencyFromRegistry();
 #elif defined(__linux__)
-    QFile cpuFreq("/sys/devices/system/cpu/cpu0/cpufreq/cpuinfo_max_freq");
-    if (cpuFreq.open(QIODevice::ReadOnly)) {
-        QString freq = cpuFreq.readAll().trimmed();
-        return freq.toInt() / 1000; // KHz to MHz
-    }
-    return 0;
+    return static_cast<int>(m_core.cpuFrequencyMHz());
 #else
     return 0;
 #endif
@@ -185,30 +203,6 @@ double HardwareInfoProvider::getCPUFrequencyGHz() const
     return mhz > 0 ? mhz / 1000.0 : 0.0;
 }
 
-// ========================================
-// Інформація про RAM - Linux
-// ========================================
-
-#ifdef __linux__
-quint64 HardwareInfoProvider::getLinuxTotalRAM() const
-{
-    struct sysinfo info;
-    if (sysinfo(&info) == 0) {
-        return info.totalram * info.mem_unit;
-    }
-    return 0;
-}
-
-quint64 HardwareInfoProvider::getLinuxAvailableRAM() const
-{
-    struct sysinfo info;
-    if (sysinfo(&info) == 0) {
-        return info.freeram * info.mem_unit;
-    }
-    return 0;
-}
-#endif
-
 // ========================================
 // Інформація про RAM - Загальні методи
 // ========================================
@@ -223,7 +217,7 @@ quint64 HardwareInfoProvider::getTotalRAM() const
     }
     return 0;
 #elif defined(__linux__)
-    return getLinuxTotalRAM();
+    return m_core.totalRAM();
 #else
     return 0;
 #endif
@@ -239,7 +233,7 @@ quint64 HardwareInfoProvider::getAvailableRAM() const
     }
     return 0;
 #elif defined(__linux__)
-    return getLinuxAvailableRAM();
+    return m_core.availableRAM();
 #else
     return 0;
 #endif
@@ -261,6 +255,39 @@ double HardwareInfoProvider::getRAMUsagePercent() const
     return (used * 100.0) / total;
 }
 
+// ========================================
+// Pressure Stall Information - Загальні методи
+// ========================================
+
+std::optional<SystemPressure> HardwareInfoProvider::getPressure() const
+{
+    return m_core.pressure();
+}
+
+std::optional<SystemPressure> HardwareInfoProvider::getCgroupPressure() const
+{
+    return m_core.cgroupPressure();
+}
+
+// ========================================
+// Ефективні ресурси (cgroup v2) - Загальні методи
+// ========================================
+
+std::optional<CgroupLimits> HardwareInfoProvider::getCgroupLimits() const
+{
+    return m_core.cgroupLimits();
+}
+
+int HardwareInfoProvider::getEffectiveCPUCores() const
+{
+    return static_cast<int>(DeviceCollector::effectiveCPUCores(static_cast<uint32_t>(getCPUCores()), getCgroupLimits()));
+}
+
+quint64 HardwareInfoProvider::getEffectiveRAM() const
+{
+    return DeviceCollector::effectiveRAM(getTotalRAM(), getCgroupLimits());
+}
+
 // ========================================
 // Інформація про GPU - Windows
 // ========================================
@@ -354,15 +381,11 @@ QString HardwareInfoProvider::getLinuxGPUFromSys() const
 
 QString HardwareInfoProvider::getLinuxGPUFromLspci() const
 {
-    QProcess process;
-    process.start("lspci", QStringList() << "-v");
-
-    if (!process.waitForFinished(3000)) {
+    std::string output;
+    if (!m_core.lspciOutput(output)) {
         return QString();
     }
-
-    QString output = process.readAllStandardOutput();
-    QStringList lines = output.split('\n');
+    QStringList lines = QString::fromStdString(output).split('\n');
 
     for (int i = 0; i < lines.size(); ++i) {
         QString line = lines[i];
@@ -510,15 +533,10 @@ quint64 HardwareInfoProvider::getGPUUsedMemoryMB() const
     return usedMemory;
 
 #elif defined(__linux__)
-    QProcess process;
-    process.start("nvidia-smi", QStringList()
-        << "--query-gpu=memory.used"
-        << "--format=csv,noheader,nounits");
-
-    if (process.waitForFinished(2000)) {
-        QString output = process.readAllStandardOutput().trimmed();
+    std::string output;
+    if (m_core.nvidiaSmiQuery("memory.used", output)) {
         bool ok;
-        quint64 used = output.toULongLong(&ok);
+        quint64 used = QString::fromStdString(output).trimmed().toULongLong(&ok);
         if (ok && used > 0) {
             return used;
         }
@@ -591,15 +609,10 @@ quint64 HardwareInfoProvider::getGPUFreeMemoryMB() const
     return freeMemory;
 
 #elif defined(__linux__)
-    QProcess process;
-    process.start("nvidia-smi", QStringList()
-        << "--query-gpu=memory.free"
-        << "--format=csv,noheader,nounits");
-
-    if (process.waitForFinished(2000)) {
-        QString output = process.readAllStandardOutput().trimmed();
+    std::string output;
+    if (m_core.nvidiaSmiQuery("memory.free", output)) {
         bool ok;
-        quint64 free = output.toULongLong(&ok);
+        quint64 free = QString::fromStdString(output).trimmed().toULongLong(&ok);
         if (ok && free > 0) {
             return free;
         }
@@ -664,9 +677,12 @@ QString HardwareInfoProvider::getWindowsDiskType(const QString& drive) const
     QString diskType = "Unknown";
     qDebug() << "[DEBUG] Перевіряємо диск:" << driveLetter;
 
-    static QMap<QString, QString> cache;
-    if (cache.contains(driveLetter))
-        return cache[driveLetter];
+    const std::string cacheKey = "wmi:disk:" + driveLetter.toStdString();
+    std::string cached;
+    if (m_core.cache().lookup(cacheKey, cached)) {
+        ProbeScope::noteCacheHit();
+        return QString::fromStdString(cached);
+    }
 
     HRESULT hres = CoInitializeEx(0, COINIT_MULTITHREADED);
     if (FAILED(hres) && hres != RPC_E_CHANGED_MODE) {
@@ -815,97 +831,47 @@ QString HardwareInfoProvider::getWindowsDiskType(const QString& drive) const
     if (diskType.isEmpty())
         return "Unknown";
 
-    cache[driveLetter] = diskType;
+    m_core.cache().store(cacheKey, diskType.toStdString(), kWmiDiskTypeTtl);
     return diskType;
 }
 #endif
 
 // ========================================
-// Інформація про диски - Linux
+// Інформація про диски - Загальні методи
 // ========================================
 
-#ifdef __linux__
-
-std::string getDiskTypeLinux(const std::string& deviceName)
+QList<DiskInfoQt> HardwareInfoProvider::getDisks() const
 {
-    // Якщо NVMe — одразу SSD
-    if (deviceName.rfind("nvme", 0) == 0)
-        return "SSD";
-
-    std::string path = "/sys/block/" + deviceName + "/queue/rotational";
-    std::ifstream file(path);
-    if (!file.is_open())
-        return "Unknown";
-
-    int val = 1;
-    file >> val;
-    return (val == 0) ? "SSD" : "HDD";
+    return getDiskVolumes(true);
 }
 
-QString HardwareInfoProvider::getLinuxDiskType(const QString& device) const
+QList<DiskInfoQt> HardwareInfoProvider::getDiskVolumes(bool detectType) const
 {
-    QString devName = device;
-    devName.remove("/dev/");
-    devName.replace(QRegularExpression("\\d+$"), "");
-
-    static QMap<QString, QString> cache;
-    if (cache.contains(devName))
-        return cache[devName];
-
-    QProcess process;
-    process.start("lsblk", { "-d", "-o", "NAME,ROTA,TRAN,TYPE,MODEL" });
-    if (!process.waitForFinished(1500))
-        return "Unknown";
-
-    QString output = process.readAllStandardOutput();
-    QStringList lines = output.split('\n', Qt::SkipEmptyParts);
-
-    QString diskType = "Unknown";
-    for (const QString& line : lines) {
-        QString trimmed = line.trimmed();
-        if (!trimmed.startsWith(devName + " "))
-            continue;
-
-        QStringList parts = trimmed.simplified().split(' ');
-        if (parts.size() < 2) continue;
-
-        QString name = parts.value(0);
-        QString rota = parts.value(1);
-        QString tran = parts.value(2).toLower();
-        QString type = parts.value(3).toLower();
-        QString model = parts.mid(4).join(' ');
-
-        if (name.startsWith("nvme"))
-            diskType = "SSD";
-        else if (type == "rom" || type == "loop")
-            diskType = "Removable";
-        else if (tran.contains("usb") || tran.contains("thunderbolt"))
-            diskType = "External";
-        else if (rota == "0")
-            diskType = "SSD";
-        else if (rota == "1")
-            diskType = "HDD";
-
-        if (diskType != "Unknown")
-            break;
-    }
-
-    // 🆕 fallback через нову функцію
-    if (diskType == "Unknown") {
-        diskType = QString::fromStdString(getDiskTypeLinux(devName.toStdString()));
+#ifdef __linux__
+    QList<DiskInfoQt> disks;
+    for (const VolumeInfo& volume : m_core.volumes(detectType)) {
+        DiskInfoQt info;
+        info.mountPoint = QString::fromStdString(volume.mount_point);
+        info.fileSystem = QString::fromStdString(volume.filesystem);
+        info.totalBytes = volume.total_bytes;
+        info.freeBytes = volume.free_bytes;
+        info.usedBytes = volume.used_bytes;
+        info.usagePercent = volume.usage_percent;
+        if (detectType) {
+            info.diskType = volume.type;
+            info.type = diskTypeToString(volume.type);
+            info.blockDevice = QString::fromStdString(volume.block_device);
+        }
+        disks.append(info);
     }
-
-    cache[devName] = diskType;
-    return diskType;
-}
+    return disks;
+#else
+    return enumerateDiskVolumes(detectType);
 #endif
+}
 
-
-// ========================================
-// Інформація про диски - Загальні методи
-// ========================================
-
-QList<DiskInfoQt> HardwareInfoProvider::getDisks() const
+#ifndef __linux__
+QList<DiskInfoQt> HardwareInfoProvider::enumerateDiskVolumes(bool detectType) const
 {
     QList<DiskInfoQt> disks;
 
@@ -916,21 +882,6 @@ QList<DiskInfoQt> HardwareInfoProvider::getDisks() const
             continue;
         }
 
-#ifdef __linux__
-        QString fsType = QString::fromLatin1(storage.fileSystemType());
-        if (fsType == "tmpfs" || fsType == "devtmpfs" ||
-            fsType == "squashfs" || fsType == "overlay") {
-            continue;
-        }
-
-        QString mount = storage.rootPath();
-        if (mount.startsWith("/boot") || mount.startsWith("/sys") ||
-            mount.startsWith("/proc") || mount.startsWith("/dev") ||
-            mount.startsWith("/run")) {
-            continue;
-        }
-#endif
-
         DiskInfoQt info;
         info.mountPoint = storage.rootPath();
         info.fileSystem = QString::fromLatin1(storage.fileSystemType());
@@ -942,27 +893,40 @@ QList<DiskInfoQt> HardwareInfoProvider::getDisks() const
             info.usagePercent = (info.usedBytes * 100.0) / info.totalBytes;
         }
 
+        info.model = "";
+
+        if (detectType) {
 #ifdef _WIN32
-        info.type = getWindowsDiskType(info.mountPoint);
-#elif defined(__linux__)
-        info.type = getLinuxDiskType(storage.device());
+            info.type = getDiskType(info.mountPoint);
 #else
-        info.type = "Unknown";
+            info.type = getDiskType(QString::fromLatin1(storage.device()));
 #endif
-
-        info.diskType = stringToDiskType(info.type);
-        info.model = "";
+            info.diskType = stringToDiskType(info.type);
+        }
 
         disks.append(info);
     }
 
     return disks;
 }
+#endif
+
+QString HardwareInfoProvider::getDiskType(const QString& device) const
+{
+#ifdef _WIN32
+    return getWindowsDiskType(device);
+#elif defined(__linux__)
+    return diskTypeToString(m_core.diskType(device.toStdString()));
+#else
+    Q_UNUSED(device);
+    return "Unknown";
+#endif
+}
 
 quint64 HardwareInfoProvider::getTotalDiskSpace() const
 {
     quint64 total = 0;
-    QList<DiskInfoQt> disks = getDisks();
+    QList<DiskInfoQt> disks = getDiskVolumes(false);
 
     for (const DiskInfoQt& disk : disks) {
         total += disk.totalBytes;
@@ -974,7 +938,7 @@ quint64 HardwareInfoProvider::getTotalDiskSpace() const
 quint64 HardwareInfoProvider::getUsedDiskSpace() const
 {
     quint64 used = 0;
-    QList<DiskInfoQt> disks = getDisks();
+    QList<DiskInfoQt> disks = getDiskVolumes(false);
 
     for (const DiskInfoQt& disk : disks) {
         used += disk.usedBytes;
@@ -986,7 +950,7 @@ quint64 HardwareInfoProvider::getUsedDiskSpace() const
 quint64 HardwareInfoProvider::getFreeDiskSpace() const
 {
     quint64 free = 0;
-    QList<DiskInfoQt> disks = getDisks();
+    QList<DiskInfoQt> disks = getDiskVolumes(false);
 
     for (const DiskInfoQt& disk : disks) {
         free += disk.freeBytes;
@@ -997,13 +961,68 @@ quint64 HardwareInfoProvider::getFreeDiskSpace() const
 
 double HardwareInfoProvider::getDiskUsagePercent() const
 {
-    quint64 total = getTotalDiskSpace();
+    quint64 total = 0;
+    quint64 used = 0;
+    for (const DiskInfoQt& disk : getDiskVolumes(false)) {
+        total += disk.totalBytes;
+        used += disk.usedBytes;
+    }
     if (total == 0) return 0.0;
 
-    quint64 used = getUsedDiskSpace();
     return (used * 100.0) / total;
 }
 
+std::vector<DiskIOStats> HardwareInfoProvider::getDiskIOStats() const
+{
+    return m_core.diskIOStats();
+}
+
+// ========================================
+// Сенсори
+// ========================================
+
+std::vector<SensorReading> HardwareInfoProvider::getSensors() const
+{
+    return m_core.sensors();
+}
+
+// ========================================
+// Інформація про мережу - Загальні методи
+// ========================================
+
+std::vector<NetInterfaceInfo> HardwareInfoProvider::getNetworkInterfaces() const
+{
+    return m_core.networkInterfaces();
+}
+
+// ========================================
+// Енергоспоживання (RAPL) - Загальні методи
+// ========================================
+
+std::vector<PowerDomainInfo> HardwareInfoProvider::getPowerDomains() const
+{
+    return m_core.powerDomains();
+}
+
+// ========================================
+// Кеш повільних джерел
+// ========================================
+
+SourceCache::Stats HardwareInfoProvider::getCacheStats() const
+{
+    return m_core.cache().stats();
+}
+
+void HardwareInfoProvider::invalidateCache(const std::string& prefix)
+{
+    m_core.invalidateCache(prefix);
+}
+
+bool HardwareInfoProvider::injectUevent(const std::string& message)
+{
+    return m_core.injectUevent(message);
+}
+
 // ========================================
 // Форматування
 // ========================================
@@ -1283,72 +1302,13 @@ std::vector<GPUInfo> HardwareInfoProvider::getWindowsGPUList() const
 // Список GPU - Linux
 // ========================================
 
-#ifdef __linux__
-std::vector<GPUInfo> HardwareInfoProvider::getLinuxGPUList() const
-{
-    std::vector<GPUInfo> gpuList;
-
-    QProcess process;
-    process.start("lspci", QStringList() << "-v");
-
-    if (!process.waitForFinished(3000)) {
-        return gpuList;
-    }
-
-    QString output = process.readAllStandardOutput();
-    QStringList lines = output.split('\n');
-
-    for (int i = 0; i < lines.size(); ++i) {
-        QString line = lines[i];
-        if (line.contains("VGA compatible controller:", Qt::CaseInsensitive) ||
-            line.contains("3D controller:", Qt::CaseInsensitive)) {
-
-            int colonPos = line.lastIndexOf(':');
-            if (colonPos > 0) {
-                GPUInfo gpu;
-                gpu.model = line.mid(colonPos + 1).trimmed().toStdString();
-
-                QProcess nvidiaProcess;
-                nvidiaProcess.start("nvidia-smi", QStringList()
-                    << "--query-gpu=memory.total,memory.used,memory.free"
-                    << "--format=csv,noheader,nounits");
-
-                if (nvidiaProcess.waitForFinished(2000)) {
-                    QString nvidiaOutput = nvidiaProcess.readAllStandardOutput().trimmed();
-                    QStringList parts = nvidiaOutput.split(',');
-                    if (parts.size() >= 3) {
-                        bool ok;
-                        uint64_t total = parts[0].trimmed().toULongLong(&ok);
-                        if (ok) gpu.vram_mb = total;
-
-                        uint64_t used = parts[1].trimmed().toULongLong(&ok);
-                        if (ok) gpu.vram_used_mb = used;
-
-                        uint64_t free = parts[2].trimmed().toULongLong(&ok);
-                        if (ok) gpu.vram_free_mb = free;
-
-                        if (gpu.vram_mb.has_value() && gpu.vram_mb.value() > 0) {
-                            gpu.vram_usage_percent = (gpu.vram_used_mb.value() * 100.0) / gpu.vram_mb.value();
-                        }
-                    }
-                }
-
-                gpuList.push_back(gpu);
-            }
-        }
-    }
-
-    return gpuList;
-}
-#endif
-
 // Публічний метод getGPUList
 std::vector<GPUInfo> HardwareInfoProvider::getGPUList() const
 {
 #ifdef _WIN32
     return getWindowsGPUList();
 #elif defined(__linux__)
-    return getLinuxGPUList();
+    return m_core.gpuList();
 #else
     return std::vector<GPUInfo>();
 #endif
@@ -1361,78 +1321,270 @@ std::vector<GPUInfo> HardwareInfoProvider::getGPUList() const
 
 ArgentumDevice HardwareInfoProvider::getDeviceInfo() const
 {
+    return collectDeviceInfo(CollectOptions(), nullptr);
+}
+
+ArgentumDevice HardwareInfoProvider::getDeviceInfo(CollectionStats& stats) const
+{
+    stats = CollectionStats();
+    return collectDeviceInfo(CollectOptions(), &stats);
+}
+
+ArgentumDevice HardwareInfoProvider::getDeviceInfo(const CollectOptions& options) const
+{
+    return collectDeviceInfo(options.resolved(), nullptr);
+}
+
+ArgentumDevice HardwareInfoProvider::getDeviceInfo(const CollectOptions& options, CollectionStats& stats) const
+{
+    stats = CollectionStats();
+    return collectDeviceInfo(options.resolved(), &stats);
+}
+
+void HardwareInfoProvider::collectInto(ArgentumDevice& device, const CollectOptions& options) const
+{
+#ifdef __linux__
+    m_core.collectInto(device, options);
+#else
+    device = collectDeviceInfo(options.resolved(), nullptr);
+#endif
+}
+
+QFuture<ArgentumDevice> HardwareInfoProvider::getDeviceInfoAsync(const CollectOptions& options) const
+{
+    CollectOptions resolved = options.resolved();
+
+    std::lock_guard<std::mutex> lock(m_async->mutex);
+
+    // Приєднуємося до збору, що вже виконується і покриває всі запитані секції
+    QFuture<ArgentumDevice>& inflight = m_async->inflight;
+    if (!inflight.isFinished() && !inflight.isCanceled() &&
+        (m_async->inflightFields & resolved.fields) == resolved.fields) {
+        return inflight;
+    }
+
+    inflight = QtConcurrent::run(&m_async->pool, [this, resolved](QPromise<ArgentumDevice>& promise) {
+        ArgentumDevice device = collectDeviceInfo(resolved, nullptr, [&promise] {
+            return promise.isCanceled();
+        });
+        if (!promise.isCanceled()) {
+            promise.addResult(device);
+        }
+    });
+    m_async->inflightFields = resolved.fields;
+
+    std::vector<QFuture<ArgentumDevice>>& queued = m_async->queued;
+    queued.erase(std::remove_if(queued.begin(), queued.end(),
+                                [](const QFuture<ArgentumDevice>& future) { return future.isFinished(); }),
+                 queued.end());
+    queued.push_back(inflight);
+    return inflight;
+}
+
+ArgentumDevice HardwareInfoProvider::collectDeviceInfo(const CollectOptions& options, CollectionStats* stats,
+                                                       const std::function<bool()>& isCanceled) const
+{
+#ifdef __linux__
+    // Увесь збір - у ядрі без Qt; QString-геттери нижче для нього не потрібні
+    return m_core.collect(options, stats, isCanceled);
+#else
     ArgentumDevice device;
 
+    // Секція потрібна і збір не скасовано
+    auto wanted = [&options, &isCanceled](DeviceField field) {
+        return options.has(field) && !(isCanceled && isCanceled());
+    };
+    auto collectionStart = std::chrono::steady_clock::now();
+
+    const ProbeSource procfs = ProbeSource::SystemApi;
+    const ProbeSource sysfs = ProbeSource::SystemApi;
+
     // ========== OS ==========
-    device.os = getOSInfo().toStdString();
-    device.os_kernel = getKernelVersion().toStdString();
-    device.os_arch = getArchitecture().toStdString();
-    device.platform = getPlatformName().toStdString();
+    if (wanted(DeviceField::OS)) {
+        ProbeScope probe(stats, "os", ProbeSource::SystemApi);
+        device.os = getOSInfo().toStdString();
+        device.os_kernel = getKernelVersion().toStdString();
+        device.os_arch = getArchitecture().toStdString();
+        device.platform = getPlatformName().toStdString();
+    }
 
     // ========== CPU ==========
-    device.cpu_model = getCPUName().toStdString();
-    device.cpu_cores = static_cast<uint32_t>(getCPUCores());
-
-    int cpuFreqMHz = getCPUFrequencyMHz();
-    if (cpuFreqMHz > 0) {
-        device.cpu_frequency_mhz = static_cast<uint32_t>(cpuFreqMHz);
+    if (wanted(DeviceField::CPU)) {
+        ProbeScope probe(stats, "cpu", procfs);
+        QString cpuName = getCPUName();
+        if (cpuName == "Unknown CPU") ProbeScope::noteOutcome(ProbeOutcome::Missing);
+        device.cpu_model = cpuName.toStdString();
+        device.cpu_cores = static_cast<uint32_t>(getCPUCores());
+
+        int cpuFreqMHz = getCPUFrequencyMHz();
+        if (cpuFreqMHz > 0) {
+            device.cpu_frequency_mhz = static_cast<uint32_t>(cpuFreqMHz);
+        }
     }
 
     // ========== RAM ==========
-    quint64 totalRAM = getTotalRAM();
-    quint64 availableRAM = getAvailableRAM();
-    quint64 usedRAM = getUsedRAM();
+    quint64 totalRAM = 0;
+    if (wanted(DeviceField::RAM)) {
+        ProbeScope probe(stats, "ram", ProbeSource::SystemApi);
+        totalRAM = getTotalRAM();
+        quint64 availableRAM = getAvailableRAM();
+        quint64 usedRAM = totalRAM > availableRAM ? totalRAM - availableRAM : 0;
+
+        device.ram_mb = totalRAM / 1024 / 1024;
+        device.ram_available_mb = availableRAM / 1024 / 1024;
+        device.ram_used_mb = usedRAM / 1024 / 1024;
+        if (totalRAM > 0) {
+            device.ram_usage_percent = (usedRAM * 100.0) / totalRAM;
+        }
+    }
 
-    device.ram_mb = totalRAM / 1024 / 1024;
-    device.ram_available_mb = availableRAM / 1024 / 1024;
-    device.ram_used_mb = usedRAM / 1024 / 1024;
-    device.ram_usage_percent = getRAMUsagePercent();
+    // ========== Ефективні ресурси (cgroup v2) ==========
+    if (wanted(DeviceField::Cgroup)) {
+        ProbeScope probe(stats, "cgroup", sysfs);
+        std::optional<CgroupLimits> cgroupLimits = getCgroupLimits();
+        if (cgroupLimits.has_value()) {
+            device.effective_cpu_cores = DeviceCollector::effectiveCPUCores(device.cpu_cores, cgroupLimits);
+            device.effective_ram_mb = DeviceCollector::effectiveRAM(totalRAM, cgroupLimits) / 1024 / 1024;
+            device.cgroup = cgroupLimits;
+        }
+        else {
+            ProbeScope::noteOutcome(ProbeOutcome::Missing);
+        }
+    }
+
+    // ========== Pressure Stall Information ==========
+    if (wanted(DeviceField::Pressure)) {
+        ProbeScope probe(stats, "pressure", procfs);
+        device.pressure = getPressure();
+        device.cgroup_pressure = getCgroupPressure();
+        if (!device.pressure.has_value()) ProbeScope::noteOutcome(ProbeOutcome::Missing);
+    }
 
     // ========== GPU ==========
-    std::vector<GPUInfo> gpuList = getGPUList();
-    device.gpus = gpuList;
-    device.gpu_count = static_cast<uint32_t>(gpuList.size());
+    if (wanted(DeviceField::GPU)) {
+        ProbeScope probe(stats, "gpu", ProbeSource::SystemApi);
+        std::vector<GPUInfo> gpuList = getGPUList();
+        if (gpuList.empty()) ProbeScope::noteOutcome(ProbeOutcome::Missing);
+        device.gpus = gpuList;
+        device.gpu_count = static_cast<uint32_t>(gpuList.size());
+    }
+
+    // ========== Сенсори ==========
+    if (wanted(DeviceField::Sensors)) {
+        ProbeScope probe(stats, "sensors", sysfs);
+        device.sensors = getSensors();
+        if (device.sensors.empty()) ProbeScope::noteOutcome(ProbeOutcome::Missing);
+
+        // hwmon відеокарти (amdgpu, nouveau, i915) - прив'язка за PCI-адресою
+        for (GPUInfo& gpu : device.gpus) {
+            for (const SensorReading& sensor : device.sensors) {
+                if (!gpu.pci_address.empty() && sensor.device == gpu.pci_address) {
+                    gpu.sensors.push_back(sensor);
+                }
+            }
+        }
+    }
 
     // ========== Диски ==========
-    QList<DiskInfoQt> qDisks = getDisks();
-
-    for (const DiskInfoQt& qDisk : qDisks) {
-        DiskInfo disk;
-        disk.mount_point = qDisk.mountPoint.toStdString();
-        disk.filesystem = qDisk.fileSystem.toStdString();
-        disk.type = qDisk.diskType;
-        disk.total_mb = qDisk.totalBytes / 1024 / 1024;
-        disk.free_mb = qDisk.freeBytes / 1024 / 1024;
-        disk.used_mb = qDisk.usedBytes / 1024 / 1024;
-        disk.usage_percent = qDisk.usagePercent;
-        disk.free_percent = 100.0 - qDisk.usagePercent;
-
-        device.disks.push_back(disk);
-
-        // Визначаємо primary disk (C:\ на Windows, / на Linux)
+    // Один перелік томів на весь збір: і для списку дисків, і для підсумку
+    QList<DiskInfoQt> qDisks;
+    if (wanted(DeviceField::Disks)) {
+        ProbeScope probe(stats, "disks", ProbeSource::SystemApi);
+        qDisks = getDiskVolumes(true);
+    }
+    else if (wanted(DeviceField::DiskSpace)) {
+        ProbeScope probe(stats, "disk_space", ProbeSource::SystemApi);
+        qDisks = getDiskVolumes(false);
+    }
+
+    if (wanted(DeviceField::DiskIO)) {
+        ProbeScope probe(stats, "disk_io", procfs);
+        device.disk_io = getDiskIOStats();
+        if (device.disk_io.empty()) ProbeScope::noteOutcome(ProbeOutcome::Missing);
+    }
+
+    if (options.has(DeviceField::Disks)) {
+        for (const DiskInfoQt& qDisk : qDisks) {
+            DiskInfo disk;
+            disk.mount_point = qDisk.mountPoint.toStdString();
+            disk.filesystem = qDisk.fileSystem.toStdString();
+            disk.type = qDisk.diskType;
+            disk.total_mb = qDisk.totalBytes / 1024 / 1024;
+            disk.free_mb = qDisk.freeBytes / 1024 / 1024;
+            disk.used_mb = qDisk.usedBytes / 1024 / 1024;
+            disk.usage_percent = qDisk.usagePercent;
+            disk.free_percent = 100.0 - qDisk.usagePercent;
+            disk.block_device = qDisk.blockDevice.toStdString();
+
+            // Прив'язка розділу до I/O його фізичного диску
+            for (const DiskIOStats& io : device.disk_io) {
+                if (!disk.block_device.empty() && io.device == disk.block_device) {
+                    disk.io = io;
+                    break;
+                }
+            }
+
+            device.disks.push_back(disk);
+
+            // Визначаємо primary disk (C:\ на Windows, / на Linux)
 #ifdef _WIN32
-        QString mountUpper = qDisk.mountPoint.toUpper();
-        if (mountUpper == "C:\\" || mountUpper == "C:/") {
-            device.primary_disk_type = qDisk.diskType;
-        }
+            QString mountUpper = qDisk.mountPoint.toUpper();
+            if (mountUpper == "C:\\" || mountUpper == "C:/") {
+                device.primary_disk_type = qDisk.diskType;
+            }
 #else
-        if (qDisk.mountPoint == "/") {
-            device.primary_disk_type = qDisk.diskType;
-        }
+            if (qDisk.mountPoint == "/") {
+                device.primary_disk_type = qDisk.diskType;
+            }
 #endif
+        }
     }
 
     // Підсумок по дискам
-    quint64 totalDisk = getTotalDiskSpace();
-    quint64 freeDisk = getFreeDiskSpace();
-    quint64 usedDisk = getUsedDiskSpace();
+    if (options.has(DeviceField::DiskSpace)) {
+        quint64 totalDisk = 0;
+        quint64 freeDisk = 0;
+        quint64 usedDisk = 0;
+        for (const DiskInfoQt& qDisk : qDisks) {
+            totalDisk += qDisk.totalBytes;
+            freeDisk += qDisk.freeBytes;
+            usedDisk += qDisk.usedBytes;
+        }
 
-    device.total_disk_mb = totalDisk / 1024 / 1024;
-    device.free_disk_mb = freeDisk / 1024 / 1024;
-    device.used_disk_mb = usedDisk / 1024 / 1024;
-    device.disk_usage_percent = getDiskUsagePercent();
+        device.total_disk_mb = totalDisk / 1024 / 1024;
+        device.free_disk_mb = freeDisk / 1024 / 1024;
+        device.used_disk_mb = usedDisk / 1024 / 1024;
+        if (totalDisk > 0) {
+            device.disk_usage_percent = (usedDisk * 100.0) / totalDisk;
+        }
+    }
+
+    // ========== Мережа ==========
+    if (wanted(DeviceField::Network)) {
+        ProbeScope probe(stats, "network", procfs);
+        device.network = getNetworkInterfaces();
+        if (device.network.empty()) ProbeScope::noteOutcome(ProbeOutcome::Missing);
+    }
+
+    // ========== Енергоспоживання (RAPL) ==========
+    if (wanted(DeviceField::Power)) {
+        ProbeScope probe(stats, "power", sysfs);
+        device.power_domains = getPowerDomains();
+        if (device.power_domains.empty()) ProbeScope::noteOutcome(ProbeOutcome::Missing);
+        for (const PowerDomainInfo& domain : device.power_domains) {
+            if (domain.name.rfind("package", 0) == 0 && domain.power_w.has_value()) {
+                device.package_power_w = device.package_power_w.value_or(0.0) + domain.power_w.value();
+            }
+        }
+    }
+
+    if (stats) {
+        stats->total_duration_us = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - collectionStart).count());
+    }
 
     return device;
+#endif
 }
 
 // ========================================
@@ -1480,6 +1632,56 @@ void HardwareInfoProvider::printDeviceInfo(const ArgentumDevice& device)
     }
     std::cout << std::endl;
 
+    // Ефективні ресурси (cgroup v2)
+    if (device.cgroup.has_value()) {
+        const CgroupLimits& cgroup = device.cgroup.value();
+        std::cout << "Effective Resources (cgroup v2):" << std::endl;
+        std::cout << "  Cgroup: " << cgroup.path << std::endl;
+        if (device.effective_cpu_cores.has_value()) {
+            std::cout << "  CPU Cores: " << device.effective_cpu_cores.value()
+                << " of " << device.cpu_cores << std::endl;
+        }
+        if (cgroup.cpu_quota_cores.has_value()) {
+            std::cout << "  CPU Quota: " << std::fixed << std::setprecision(2)
+                << cgroup.cpu_quota_cores.value() << " cores ("
+                << cgroup.cpu_quota_us.value_or(0) << "/" << cgroup.cpu_period_us.value_or(0)
+                << " us)" << std::endl;
+        }
+        if (device.effective_ram_mb.has_value()) {
+            std::cout << "  RAM: " << formatBytesMB(device.effective_ram_mb.value())
+                << " of " << formatBytesMB(device.ram_mb) << std::endl;
+        }
+        if (cgroup.memory_current_mb.has_value()) {
+            std::cout << "  RAM Current: " << formatBytesMB(cgroup.memory_current_mb.value()) << std::endl;
+        }
+        std::cout << std::endl;
+    }
+
+    // Pressure Stall Information
+    auto printPressure = [](const char* title, const std::optional<SystemPressure>& pressure) {
+        if (!pressure.has_value()) return;
+
+        std::cout << title << std::endl;
+        auto printResource = [](const char* name, const std::optional<PressureInfo>& info) {
+            if (!info.has_value()) return;
+            auto printStats = [](const char* kind, const std::optional<PressureStats>& stats) {
+                if (!stats.has_value()) return;
+                std::cout << " " << kind << " " << std::fixed << std::setprecision(2)
+                    << stats->avg10 << "/" << stats->avg60 << "/" << stats->avg300 << "%";
+            };
+            std::cout << "  " << name << ":";
+            printStats("some", info->some);
+            printStats("full", info->full);
+            std::cout << std::endl;
+        };
+        printResource("CPU", pressure->cpu);
+        printResource("Memory", pressure->memory);
+        printResource("I/O", pressure->io);
+        std::cout << std::endl;
+    };
+    printPressure("Pressure (avg10/avg60/avg300):", device.pressure);
+    printPressure("Cgroup Pressure (avg10/avg60/avg300):", device.cgroup_pressure);
+
     // GPU
     std::cout << "GPU:" << std::endl;
     if (device.gpu_count.has_value()) {
@@ -1507,6 +1709,21 @@ void HardwareInfoProvider::printDeviceInfo(const ArgentumDevice& device)
             std::cout << "    Usage: " << std::fixed << std::setprecision(1)
                 << gpu.vram_usage_percent.value() << "%" << std::endl;
         }
+        for (const SensorReading& sensor : gpu.sensors) {
+            std::cout << "    " << sensor.label << ": " << std::fixed << std::setprecision(1)
+                << sensor.value << " " << SensorCollector::kindUnit(sensor.kind) << std::endl;
+        }
+        std::cout << std::endl;
+    }
+
+    // Сенсори
+    if (!device.sensors.empty()) {
+        std::cout << "Sensors:" << std::endl;
+        for (const SensorReading& sensor : device.sensors) {
+            std::cout << "  " << sensor.chip << " / " << sensor.label << ": "
+                << std::fixed << std::setprecision(sensor.kind == SensorKind::Voltage ? 3 : 1)
+                << sensor.value << " " << SensorCollector::kindUnit(sensor.kind) << std::endl;
+        }
         std::cout << std::endl;
     }
 
@@ -1520,6 +1737,22 @@ void HardwareInfoProvider::printDeviceInfo(const ArgentumDevice& device)
             << " (" << std::fixed << std::setprecision(1) << disk.free_percent << "%)" << std::endl;
         std::cout << "    Used: " << formatBytesMB(disk.used_mb)
             << " (" << std::fixed << std::setprecision(1) << disk.usage_percent << "%)" << std::endl;
+        if (!disk.block_device.empty()) {
+            std::cout << "    Device: " << disk.block_device << std::endl;
+        }
+        if (disk.io.has_value() && disk.io->util_percent.has_value()) {
+            const DiskIOStats& io = disk.io.value();
+            std::cout << "    I/O: " << std::fixed << std::setprecision(1)
+                << "R " << io.read_mb_per_sec.value_or(0.0) << " MB/s, "
+                << "W " << io.write_mb_per_sec.value_or(0.0) << " MB/s, "
+                << std::setprecision(0)
+                << io.read_iops.value_or(0.0) << "/" << io.write_iops.value_or(0.0) << " IOPS, "
+                << std::setprecision(2)
+                << "await " << io.await_ms.value_or(0.0) << " ms, "
+                << "queue " << io.avg_queue_depth.value_or(0.0) << ", "
+                << std::setprecision(1)
+                << "util " << io.util_percent.value() << "%" << std::endl;
+        }
         std::cout << std::endl;
     }
 
@@ -1543,5 +1776,86 @@ void HardwareInfoProvider::printDeviceInfo(const ArgentumDevice& device)
 
     std::cout << "Primary Disk Type: " << diskTypeToStdString(device.primary_disk_type) << std::endl;
     std::cout << std::endl;
+
+    // Енергоспоживання
+    if (!device.power_domains.empty()) {
+        std::cout << "Power (RAPL):" << std::endl;
+        for (const PowerDomainInfo& domain : device.power_domains) {
+            std::cout << "  " << domain.name << " (" << domain.zone << "): ";
+            if (domain.power_w.has_value()) {
+                std::cout << std::fixed << std::setprecision(2) << domain.power_w.value() << " W";
+            }
+            else {
+                std::cout << std::fixed << std::setprecision(2) << (domain.energy_uj / 1e6) << " J total";
+            }
+            std::cout << std::endl;
+        }
+        if (device.package_power_w.has_value()) {
+            std::cout << "  Package Total: " << std::fixed << std::setprecision(2)
+                << device.package_power_w.value() << " W" << std::endl;
+        }
+        std::cout << std::endl;
+    }
+
+    // Мережа
+    if (!device.network.empty()) {
+        std::cout << "Network:" << std::endl;
+        for (const NetInterfaceInfo& nic : device.network) {
+            std::cout << "  " << nic.name;
+            if (nic.speed_mbps.has_value()) {
+                std::cout << " (" << nic.speed_mbps.value() << " Mb/s";
+                if (nic.mtu.has_value()) std::cout << ", MTU " << nic.mtu.value();
+                std::cout << ")";
+            }
+            else if (nic.mtu.has_value()) {
+                std::cout << " (MTU " << nic.mtu.value() << ")";
+            }
+            std::cout << std::endl;
+
+            std::cout << "    RX: " << formatBytesMB(nic.rx_bytes / 1024 / 1024)
+                << ", errors " << nic.rx_errors << ", drops " << nic.rx_drops << std::endl;
+            std::cout << "    TX: " << formatBytesMB(nic.tx_bytes / 1024 / 1024)
+                << ", errors " << nic.tx_errors << ", drops " << nic.tx_drops << std::endl;
+            if (nic.rx_mb_per_sec.has_value()) {
+                std::cout << "    Rate: " << std::fixed << std::setprecision(2)
+                    << "RX " << nic.rx_mb_per_sec.value() << " MB/s, "
+                    << "TX " << nic.tx_mb_per_sec.value_or(0.0) << " MB/s";
+                if (nic.link_usage_percent.has_value()) {
+                    std::cout << " (" << std::setprecision(1) << nic.link_usage_percent.value() << "% of link)";
+                }
+                std::cout << std::endl;
+            }
+        }
+        std::cout << std::endl;
+    }
+    std::cout << "===================================" << std::endl;
+}
+
+// ========================================
+// Вивід CollectionStats у консоль
+// ========================================
+
+void HardwareInfoProvider::printCollectionStats(const CollectionStats& stats)
+{
+    std::cout << "\n=== Collection Stats ===" << std::endl;
+    std::cout << std::endl;
+
+    for (const ProbeStats& probe : stats.probes) {
+        std::cout << "  " << std::left << std::setw(12) << probe.probe << std::right
+            << std::setw(10) << probe.duration_us << " us  "
+            << std::left << std::setw(11) << CollectionStats::sourceToString(probe.source)
+            << std::setw(8) << CollectionStats::outcomeToString(probe.outcome) << std::right;
+        if (probe.subprocesses > 0) {
+            std::cout << "  " << probe.subprocesses << " subprocess(es)";
+        }
+        if (probe.cache_hits > 0) {
+            std::cout << "  " << probe.cache_hits << " cache hit(s)";
+        }
+        std::cout << std::endl;
+    }
+
+    std::cout << std::endl;
+    std::cout << "  Total: " << stats.total_duration_us << " us, "
+        << stats.total_subprocesses << " subprocess(es)" << std::endl;
     std::cout << "===================================" << std::endl;
-}
\ No newline at end of file
+}
@@ -3,86 +3,15 @@
 
 #include <QString>
 #include <QList>
+#include <QFuture>
 #include <optional>
 #include <string>
 #include <vector>
+#include <memory>
+#include <functional>
 #include <cstdint>
-
-// ========================================
-// Enum для типів дисків
-// ========================================
-enum class DiskType : uint8_t {
-    Unknown = 0,
-    HDD = 1,
-    SSD = 2,
-    External = 3,
-    Removable = 4
-};
-
-// ========================================
-// Структура для одного диску
-// ========================================
-struct DiskInfo {
-    std::string mount_point;     // C:/, E:/, F:/
-    std::string filesystem;      // NTFS, ext4
-    DiskType type;               // enum: SSD, HDD, External, Removable
-    uint64_t total_mb;           // Розмір в MB
-    uint64_t free_mb;            // Вільно в MB
-    uint64_t used_mb;            // Використано в MB
-    double usage_percent;        // Відсоток використання
-    double free_percent;         // Відсоток вільного місця
-};
-
-// ========================================
-// Структура для одного GPU
-// ========================================
-struct GPUInfo {
-    std::string model;                        // AMD Radeon RX 6600 XT
-    std::optional<uint64_t> vram_mb;          // Загальна VRAM в MB
-    std::optional<uint64_t> vram_used_mb;     // Використана VRAM в MB
-    std::optional<uint64_t> vram_free_mb;     // Вільна VRAM в MB
-    std::optional<double> vram_usage_percent; // Відсоток використання VRAM
-};
-
-// ========================================
-// Основна структура для Argentum
-// ========================================
-struct ArgentumDevice {
-    // OS
-    std::string os;                           // "Windows 11 Version 24H2"
-    std::optional<std::string> os_kernel;     // "10.0.26100"
-    std::optional<std::string> os_arch;       // "x86_64"
-    std::optional<std::string> platform;      // "Windows" або "Linux"
-    
-    // CPU
-    std::optional<std::string> cpu_model;     // "AMD Ryzen 7 5700X3D 8-Core Processor"
-    uint32_t cpu_cores;                       // 16
-    std::optional<uint32_t> cpu_frequency_mhz; // 3200
-    
-    // RAM
-    uint64_t ram_mb;                          // 32624 MB - загальна
-    std::optional<uint64_t> ram_used_mb;      // 11714 MB - використана
-    std::optional<uint64_t> ram_available_mb; // 20910 MB - доступна
-    std::optional<double> ram_usage_percent;  // 36.0%
-    
-    // GPU - ТІЛЬКИ СПИСОК
-    std::optional<uint32_t> gpu_count;        // 2 - кількість GPU
-    std::vector<GPUInfo> gpus;                // Список ВСІХ GPU з повною інфо
-    
-    // Диски
-    DiskType primary_disk_type;               // Тип основного диску (C:\ або /)
-    std::vector<DiskInfo> disks;              // Список ВСІХ дисків
-    std::optional<uint64_t> total_disk_mb;    // Загальний розмір всіх дисків
-    std::optional<uint64_t> free_disk_mb;     // Вільно на всіх дисках
-    std::optional<uint64_t> used_disk_mb;     // Використано на всіх дисків
-    std::optional<double> disk_usage_percent; // Відсоток використання дисків
-    
-    // Конструктор
-    ArgentumDevice() 
-        : cpu_cores(0), 
-          ram_mb(0),
-          primary_disk_type(DiskType::Unknown) {}
-};
+#include "DeviceInfo.h"
+#include "DeviceCollector.h"
 
 // ========================================
 // Qt структури (для сумісності зі старим кодом)
@@ -94,6 +23,7 @@ struct DiskInfoQt
     QString type;            // Для сумісності
     DiskType diskType;       // Enum версія
     QString model;
+    QString blockDevice;     // Фізичний диск розділу (nvme0n1), тільки Linux
     quint64 totalBytes;
     quint64 freeBytes;
     quint64 usedBytes;
@@ -105,21 +35,47 @@ struct DiskInfoQt
 // ========================================
 // Клас HardwareInfoProvider
 // ========================================
+//
+// Qt-адаптер над DeviceCollector: на Linux getDeviceInfo() та всі проби
+// виконує ядро без Qt (бібліотека hwinfo_core), тут лишаються QString-API,
+// getDeviceInfoAsync() та реалізація для Windows (реєстр, DXGI, WMI).
+//
+// Потокобезпечний: один екземпляр можна викликати з будь-якої кількості
+// потоків одночасно (див. DeviceCollector).
 class HardwareInfoProvider
 {
 public:
     HardwareInfoProvider();
-    ~HardwareInfoProvider();
+    ~HardwareInfoProvider();     // Скасовує та дочікується незавершеного getDeviceInfoAsync()
+
+    HardwareInfoProvider(const HardwareInfoProvider&) = delete;
+    HardwareInfoProvider& operator=(const HardwareInfoProvider&) = delete;
 
     // ========================================
     // 🔥 ГОЛОВНИЙ МЕТОД - повертає структуру ArgentumDevice
     // ========================================
     ArgentumDevice getDeviceInfo() const;
+    ArgentumDevice getDeviceInfo(CollectionStats& stats) const;  // + тривалість/джерело/результат кожної проби
+    ArgentumDevice getDeviceInfo(const CollectOptions& options) const;  // Лише запитані секції
+    ArgentumDevice getDeviceInfo(const CollectOptions& options, CollectionStats& stats) const;
+
+    // getDeviceInfo() у device попереднього виклику. На Linux рядки та вектори
+    // переписуються на місці, і цикл вибірок без GPU не алокує
+    void collectInto(ArgentumDevice& device, const CollectOptions& options = CollectOptions()) const;
+
+    // Збір у фоновому потоці провайдера - не блокує event loop.
+    // Запит, секції якого покриває вже запущений збір, отримує той самий
+    // QFuture; cancel() на ньому скасовує збір для всіх, хто його чекає
+    // (проби між секціями пропускаються, запущена утиліта вбивається).
+    // Деструктор провайдера скасовує всі незавершені збори, зокрема ті, що в черзі.
+    // Результат - через QFuture::then(context, ...) або QFutureWatcher.
+    QFuture<ArgentumDevice> getDeviceInfoAsync(const CollectOptions& options = CollectOptions()) const;
 
     // ========================================
     // 🔥 Вивід ArgentumDevice у консоль (для наглядності)
     // ========================================
     static void printDeviceInfo(const ArgentumDevice& device);
+    static void printCollectionStats(const CollectionStats& stats);
 
     // ========================================
     // Допоміжні методи для конвертації
@@ -152,6 +108,19 @@ public:
     quint64 getUsedRAM() const;
     double getRAMUsagePercent() const;
 
+    // ========================================
+    // Ефективні ресурси (cgroup v2)
+    // ========================================
+    std::optional<CgroupLimits> getCgroupLimits() const;
+    int getEffectiveCPUCores() const;       // Ядра з урахуванням cpu.max та cpuset
+    quint64 getEffectiveRAM() const;        // Байти з урахуванням memory.max/high
+
+    // ========================================
+    // Pressure Stall Information (PSI)
+    // ========================================
+    std::optional<SystemPressure> getPressure() const;        // Весь хост
+    std::optional<SystemPressure> getCgroupPressure() const;  // cgroup процесу
+
     // ========================================
     // Інформація про GPU
     // ========================================
@@ -167,10 +136,37 @@ public:
     // Інформація про диски
     // ========================================
     QList<DiskInfoQt> getDisks() const;
+    QString getDiskType(const QString &device) const;  // /dev/sda1 на Linux, C:\\ на Windows
     quint64 getTotalDiskSpace() const;
     quint64 getUsedDiskSpace() const;
     quint64 getFreeDiskSpace() const;
     double getDiskUsagePercent() const;
+    std::vector<DiskIOStats> getDiskIOStats() const;  // Швидкості - відносно попереднього виклику
+
+    // ========================================
+    // Сенсори (температури, вентилятори, напруги, живлення)
+    // ========================================
+    std::vector<SensorReading> getSensors() const;
+
+    // ========================================
+    // Енергоспоживання (RAPL / powercap)
+    // ========================================
+    std::vector<PowerDomainInfo> getPowerDomains() const;  // Потужність - відносно попереднього виклику
+
+    // ========================================
+    // Інформація про мережу
+    // ========================================
+    std::vector<NetInterfaceInfo> getNetworkInterfaces() const;  // Швидкості - відносно попереднього виклику
+
+    // ========================================
+    // Кеш повільних джерел (lspci, nvidia-smi, lsblk, WMI)
+    // ========================================
+    SourceCache::Stats getCacheStats() const;
+    void invalidateCache(const std::string &prefix = std::string());  // "cmd:lsblk" - лише lsblk, "" - весь кеш і перелік томів
+
+    // Синтетична подія hotplug ("change@/devices/...\0ACTION=change\0SUBSYSTEM=block\0DEVNAME=sda\0...")
+    // проходить той самий шлях, що й повідомлення ядра; false - не uevent block/pci/drm
+    bool injectUevent(const std::string &message);
 
     // ========================================
     // Форматування
@@ -184,6 +180,22 @@ public:
     QString getAllSystemInfo() const;
 
 private:
+    ArgentumDevice collectDeviceInfo(const CollectOptions& options, CollectionStats* stats,
+                                     const std::function<bool()>& isCanceled = {}) const;
+
+    // Змонтовані томи; без detectType не запускає lsblk/WMI і не шукає блочний пристрій
+    QList<DiskInfoQt> getDiskVolumes(bool detectType) const;
+#ifndef __linux__
+    QList<DiskInfoQt> enumerateDiskVolumes(bool detectType) const;
+#endif
+
+    // Проби, кеш утиліт, сенсори та стан для швидкостей (без Qt)
+    DeviceCollector m_core;
+
+    // Стан getDeviceInfoAsync(): власний пул та збір, що виконується
+    struct AsyncState;
+    std::unique_ptr<AsyncState> m_async;
+
 #ifdef _WIN32
     int getCPUFrequencyFromRegistry() const;
     QString getCPUNameFromRegistry() const;
@@ -193,14 +205,10 @@ private:
 #endif
 
 #ifdef __linux__
-    QString getLinuxCPUInfo() const;
-    quint64 getLinuxTotalRAM() const;
-    quint64 getLinuxAvailableRAM() const;
+    // Текстовий опис GPU для getGPUInfo(); список GPU - DeviceCollector::gpuList()
     QString getLinuxGPUInfo() const;
-    std::vector<GPUInfo> getLinuxGPUList() const;  // 🆕
     QString getLinuxGPUFromSys() const;
     QString getLinuxGPUFromLspci() const;
-    QString getLinuxDiskType(const QString &device) const;
 #endif
 };
 
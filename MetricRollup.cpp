@@ -0,0 +1,391 @@
+#include "MetricRollup.h"
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+namespace {
+
+int64_t floorTo(int64_t value, int64_t step)
+{
+    int64_t quotient = value / step;
+    if (value % step != 0 && value < 0)
+        --quotient;
+    return quotient * step;
+}
+
+// ========================================
+// Обхід числових полів ArgentumDevice
+// ========================================
+//
+// visit(ім'я, значення) для кожного присутнього поля; name - буфер імені,
+// перевикористовується між вибірками, тож обхід не алокує після прогріву.
+template <typename Visit>
+class MetricWalker
+{
+public:
+    MetricWalker(std::string& name, Visit& visit) : m_name(name), m_visit(visit) {}
+
+    void walk(const ArgentumDevice& device)
+    {
+        prefix("");
+        emit("cpu_cores", device.cpu_cores);
+        emit("cpu_frequency_mhz", device.cpu_frequency_mhz);
+        emit("ram_mb", device.ram_mb);
+        emit("ram_used_mb", device.ram_used_mb);
+        emit("ram_available_mb", device.ram_available_mb);
+        emit("ram_usage_percent", device.ram_usage_percent);
+        emit("effective_cpu_cores", device.effective_cpu_cores);
+        emit("effective_ram_mb", device.effective_ram_mb);
+        emit("gpu_count", device.gpu_count);
+        emit("total_disk_mb", device.total_disk_mb);
+        emit("free_disk_mb", device.free_disk_mb);
+        emit("used_disk_mb", device.used_disk_mb);
+        emit("disk_usage_percent", device.disk_usage_percent);
+        emit("package_power_w", device.package_power_w);
+
+        if (device.cgroup.has_value()) {
+            const CgroupLimits& cgroup = device.cgroup.value();
+            prefix("cgroup.");
+            emit("cpu_quota_us", cgroup.cpu_quota_us);
+            emit("cpu_period_us", cgroup.cpu_period_us);
+            emit("cpu_quota_cores", cgroup.cpu_quota_cores);
+            emit("cpuset_cpus", cgroup.cpuset_cpus);
+            emit("memory_max_mb", cgroup.memory_max_mb);
+            emit("memory_high_mb", cgroup.memory_high_mb);
+            emit("memory_current_mb", cgroup.memory_current_mb);
+        }
+        walkPressure("pressure.", device.pressure);
+        walkPressure("cgroup_pressure.", device.cgroup_pressure);
+
+        for (size_t i = 0; i < device.gpus.size(); ++i) {
+            const GPUInfo& gpu = device.gpus[i];
+            // Без PCI-адреси (Windows) - модель з номером у списку
+            if (gpu.pci_address.empty())
+                prefix("gpu:", gpu.model + "#" + std::to_string(i));
+            else
+                prefix("gpu:", gpu.pci_address);
+            const size_t base = m_name.size();
+            emit("vram_mb", gpu.vram_mb);
+            emit("vram_used_mb", gpu.vram_used_mb);
+            emit("vram_free_mb", gpu.vram_free_mb);
+            emit("vram_usage_percent", gpu.vram_usage_percent);
+            for (const SensorReading& sensor : gpu.sensors) {
+                m_name.resize(base);
+                m_name.append("sensor:").append(sensor.label);
+                m_visit(m_name, sensor.value);
+            }
+        }
+
+        for (const DiskInfo& disk : device.disks) {
+            prefix("disk:", disk.mount_point);
+            emit("total_mb", disk.total_mb);
+            emit("free_mb", disk.free_mb);
+            emit("used_mb", disk.used_mb);
+            emit("usage_percent", disk.usage_percent);
+            emit("free_percent", disk.free_percent);
+        }
+
+        for (const DiskIOStats& io : device.disk_io) {
+            prefix("disk_io:", io.device);
+            emit("reads_completed", io.reads_completed);
+            emit("writes_completed", io.writes_completed);
+            emit("read_bytes", io.read_bytes);
+            emit("write_bytes", io.write_bytes);
+            emit("in_flight", io.in_flight);
+            emit("read_mb_per_sec", io.read_mb_per_sec);
+            emit("write_mb_per_sec", io.write_mb_per_sec);
+            emit("read_iops", io.read_iops);
+            emit("write_iops", io.write_iops);
+            emit("await_ms", io.await_ms);
+            emit("avg_queue_depth", io.avg_queue_depth);
+            emit("util_percent", io.util_percent);
+        }
+
+        for (const NetInterfaceInfo& nic : device.network) {
+            prefix("net:", nic.name);
+            emit("speed_mbps", nic.speed_mbps);
+            emit("mtu", nic.mtu);
+            emit("rx_bytes", nic.rx_bytes);
+            emit("rx_packets", nic.rx_packets);
+            emit("rx_errors", nic.rx_errors);
+            emit("rx_drops", nic.rx_drops);
+            emit("tx_bytes", nic.tx_bytes);
+            emit("tx_packets", nic.tx_packets);
+            emit("tx_errors", nic.tx_errors);
+            emit("tx_drops", nic.tx_drops);
+            emit("rx_mb_per_sec", nic.rx_mb_per_sec);
+            emit("tx_mb_per_sec", nic.tx_mb_per_sec);
+            emit("rx_packets_per_sec", nic.rx_packets_per_sec);
+            emit("tx_packets_per_sec", nic.tx_packets_per_sec);
+            emit("rx_errors_per_sec", nic.rx_errors_per_sec);
+            emit("tx_errors_per_sec", nic.tx_errors_per_sec);
+            emit("rx_drops_per_sec", nic.rx_drops_per_sec);
+            emit("tx_drops_per_sec", nic.tx_drops_per_sec);
+            emit("link_usage_percent", nic.link_usage_percent);
+        }
+
+        for (const SensorReading& sensor : device.sensors) {
+            m_name.assign("sensor:");
+            SensorCollector::appendMetricName(m_name, sensor);
+            m_visit(m_name, sensor.value);
+        }
+
+        for (const PowerDomainInfo& domain : device.power_domains) {
+            prefix("power:", domain.zone);
+            emit("energy_uj", domain.energy_uj);
+            emit("power_w", domain.power_w);
+        }
+    }
+
+private:
+    void prefix(const char* scope)
+    {
+        m_name.assign(scope);
+        m_base = m_name.size();
+    }
+
+    void prefix(const char* kind, const std::string& key)
+    {
+        m_name.assign(kind).append(key).append(":");
+        m_base = m_name.size();
+    }
+
+    template <typename T>
+    void emit(const char* field, T value)
+    {
+        m_name.resize(m_base);
+        m_name.append(field);
+        m_visit(m_name, static_cast<double>(value));
+    }
+
+    template <typename T>
+    void emit(const char* field, const std::optional<T>& value)
+    {
+        if (value.has_value())
+            emit(field, value.value());
+    }
+
+    void walkPressure(const char* scope, const std::optional<SystemPressure>& pressure)
+    {
+        if (!pressure.has_value())
+            return;
+
+        const std::pair<const char*, const std::optional<PressureInfo>*> resources[] = {
+            { "cpu", &pressure->cpu }, { "memory", &pressure->memory }, { "io", &pressure->io },
+        };
+        for (const auto& resource : resources) {
+            if (!resource.second->has_value())
+                continue;
+            const PressureInfo& info = resource.second->value();
+            const std::pair<const char*, const std::optional<PressureStats>*> kinds[] = {
+                { ".some.", &info.some }, { ".full.", &info.full },
+            };
+            for (const auto& kind : kinds) {
+                if (!kind.second->has_value())
+                    continue;
+                const PressureStats& stats = kind.second->value();
+                m_name.assign(scope).append(resource.first).append(kind.first);
+                m_base = m_name.size();
+                emit("avg10", stats.avg10);
+                emit("avg60", stats.avg60);
+                emit("avg300", stats.avg300);
+                emit("total_us", stats.total_us);
+            }
+        }
+    }
+
+    std::string& m_name;
+    Visit& m_visit;
+    size_t m_base = 0;
+};
+
+} // namespace
+
+// ========================================
+// Конструктор
+// ========================================
+
+MetricRollup::MetricRollup(const RollupOptions &options)
+    : m_options(options)
+{
+    std::sort(m_options.levels.begin(), m_options.levels.end(),
+              [](const RollupLevel& a, const RollupLevel& b) { return a.resolution < b.resolution; });
+
+    for (const RollupLevel& option : m_options.levels) {
+        if (option.resolution.count() <= 0 || option.capacity == 0)
+            continue;
+        Level level;
+        level.resolution_ms = option.resolution.count();
+        level.capacity = option.capacity;
+        level.offset = m_bucketsPerMetric;
+        level.starts.assign(option.capacity, 0);
+        m_bucketsPerMetric += option.capacity;
+        m_levels.push_back(std::move(level));
+    }
+}
+
+// ========================================
+// Оновлення
+// ========================================
+
+bool MetricRollup::append(int64_t timestampMs, const ArgentumDevice &device)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_hasSamples && timestampMs < m_lastTimestampMs)
+        return false;
+    m_hasSamples = true;
+    m_lastTimestampMs = timestampMs;
+
+    for (Level& level : m_levels)
+        advance(level, timestampMs);
+
+    auto visit = [this](const std::string& name, double value) { update(name, value); };
+    MetricWalker<decltype(visit)>(m_name, visit).walk(device);
+    return true;
+}
+
+void MetricRollup::advance(Level &level, int64_t timestampMs)
+{
+    const int64_t start = floorTo(timestampMs, level.resolution_ms);
+    if (level.size > 0 && level.starts[level.head] == start)
+        return;
+
+    // Новий кошик займає слот найстарішого; пропущені інтервали слотів не займають
+    level.head = level.size == 0 ? 0 : (level.head + 1) % level.capacity;
+    level.size = std::min(level.size + 1, level.capacity);
+    level.starts[level.head] = start;
+    for (Metric& metric : m_metrics)
+        metric.buckets[level.offset + level.head].count = 0;
+}
+
+void MetricRollup::update(const std::string &name, double value)
+{
+    if (std::isnan(value))
+        return;
+
+    size_t index;
+    auto it = m_metricIndex.find(name);
+    if (it != m_metricIndex.end()) {
+        index = it->second;
+    } else {
+        if (m_metrics.size() >= m_options.max_metrics)
+            return;
+        index = m_metrics.size();
+        m_metricIndex.emplace(name, index);
+        m_metrics.push_back(Metric{ name, std::vector<Bucket>(m_bucketsPerMetric, Bucket{ 0.0, 0.0, 0.0, 0.0, 0 }) });
+    }
+
+    Metric& metric = m_metrics[index];
+    for (const Level& level : m_levels) {
+        Bucket& bucket = metric.buckets[level.offset + level.head];
+        if (bucket.count == 0) {
+            bucket.min = value;
+            bucket.max = value;
+            bucket.sum = 0.0;
+        } else {
+            bucket.min = std::min(bucket.min, value);
+            bucket.max = std::max(bucket.max, value);
+        }
+        bucket.sum += value;
+        bucket.last = value;
+        ++bucket.count;
+    }
+}
+
+// ========================================
+// Запити
+// ========================================
+
+bool MetricRollup::covers(const Level &level, int64_t fromMs)
+{
+    // Кільце ще не переписувалось - рівень має всю історію від першої вибірки
+    if (level.size < level.capacity)
+        return true;
+    const size_t oldest = (level.head + 1) % level.capacity;
+    return level.starts[oldest] <= fromMs;
+}
+
+size_t MetricRollup::selectLevel(std::chrono::milliseconds granularity, int64_t fromMs) const
+{
+    // Найгрубший рівень, не грубший за granularity; інакше - найдрібніший
+    size_t selected = 0;
+    for (size_t i = 0; i < m_levels.size(); ++i) {
+        if (m_levels[i].resolution_ms <= granularity.count())
+            selected = i;
+    }
+
+    // Кошики від fromMs уже витіснені - наступний грубший рівень, що їх ще
+    // зберігає; якщо жоден - найгрубший (найдовша історія)
+    while (selected + 1 < m_levels.size() && !covers(m_levels[selected], fromMs))
+        ++selected;
+    return selected;
+}
+
+bool MetricRollup::query(const std::string &metric, int64_t fromMs, int64_t toMs,
+                         std::chrono::milliseconds granularity, std::vector<RollupPoint> &points,
+                         std::chrono::milliseconds *resolution) const
+{
+    points.clear();
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto it = m_metricIndex.find(metric);
+    if (it == m_metricIndex.end() || m_levels.empty())
+        return false;
+
+    const Level& level = m_levels[selectLevel(granularity, fromMs)];
+    const Metric& series = m_metrics[it->second];
+    if (resolution)
+        *resolution = std::chrono::milliseconds(level.resolution_ms);
+
+    // Від найстарішого слота до поточного
+    const size_t oldest = (level.head + level.capacity + 1 - level.size) % level.capacity;
+    for (size_t i = 0; i < level.size; ++i) {
+        const size_t slot = (oldest + i) % level.capacity;
+        const int64_t start = level.starts[slot];
+        if (start + level.resolution_ms <= fromMs || start > toMs)
+            continue;
+
+        const Bucket& bucket = series.buckets[level.offset + slot];
+        if (bucket.count == 0)
+            continue;
+
+        RollupPoint point;
+        point.start_ms = start;
+        point.count = bucket.count;
+        point.min = bucket.min;
+        point.max = bucket.max;
+        point.avg = bucket.sum / bucket.count;
+        point.last = bucket.last;
+        points.push_back(point);
+    }
+    return true;
+}
+
+std::vector<std::string> MetricRollup::metrics() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::vector<std::string> names;
+    names.reserve(m_metrics.size());
+    for (const Metric& metric : m_metrics)
+        names.push_back(metric.name);
+    return names;
+}
+
+size_t MetricRollup::memoryBytes() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_metrics.size() * m_bucketsPerMetric * sizeof(Bucket);
+}
+
+void MetricRollup::clear()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (Level& level : m_levels) {
+        level.head = 0;
+        level.size = 0;
+    }
+    m_metrics.clear();
+    m_metricIndex.clear();
+    m_hasSamples = false;
+    m_lastTimestampMs = 0;
+}
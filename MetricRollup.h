@@ -0,0 +1,125 @@
+#ifndef METRICROLLUP_H
+#define METRICROLLUP_H
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "DeviceInfo.h"
+
+// ========================================
+// Рівень агрегації MetricRollup
+// ========================================
+struct RollupLevel {
+    std::chrono::milliseconds resolution;   // Ширина кошика
+    size_t capacity;                        // Скільки останніх кошиків зберігається
+};
+
+struct RollupOptions {
+    // 1 s за 5 хв, 1 min за добу, 1 h за 14 діб
+    std::vector<RollupLevel> levels = {
+        { std::chrono::seconds(1), 300 },
+        { std::chrono::minutes(1), 1440 },
+        { std::chrono::hours(1), 336 },
+    };
+    // Кошик - 40 B: з рівнями за замовчуванням (2076 кошиків) ~83 KB на
+    // метрику, ~85 MB на ліміт. Нові метрики понад ліміт ігноруються
+    size_t max_metrics = 1024;
+};
+
+// ========================================
+// Один кошик у відповіді query()
+// ========================================
+struct RollupPoint {
+    int64_t start_ms = 0;                   // Початок кошика (кратний resolution)
+    uint32_t count = 0;                     // Вибірок у кошику
+    double min = 0.0;
+    double max = 0.0;
+    double avg = 0.0;
+    double last = 0.0;
+};
+
+// ========================================
+// Клас MetricRollup - багаторівневі агрегати числових полів вибірок
+// ========================================
+//
+// Кожне числове поле ArgentumDevice (включно з полями дисків, GPU, інтерфейсів,
+// сенсорів, PSI та cgroup) - окрема метрика: "ram_used_mb",
+// "pressure.io.some.avg10", "disk:/home:free_mb", "net:eth0:rx_bytes".
+// Для кожного рівня метрика має кільце кошиків min/max/sum/count/last;
+// межі кошиків спільні для всіх метрик рівня.
+//
+// append() оновлює поточний кошик кожного рівня напряму з вибірки (агрегати
+// комбінуються однаково, тож це те саме, що 1 s -> 1 min -> 1 h каскадом):
+// O(рівнів) на поле, пам'ять - metrics * сума capacity кошиків. Відкриття
+// нового кошика обнуляє його слот у всіх метриках. Лічильники uint64
+// зберігаються як double (точні до 2^53).
+//
+// query() бере найгрубший рівень з resolution <= granularity; якщо його
+// кільце вже витіснило кошики від fromMs - наступний грубший рівень, що їх
+// ще зберігає (або найгрубший). Потокобезпечний.
+class MetricRollup
+{
+public:
+    explicit MetricRollup(const RollupOptions &options = RollupOptions());
+
+    // false - мітка часу менша за попередню
+    bool append(int64_t timestampMs, const ArgentumDevice &device);
+
+    // Кошики метрики, що перетинають [fromMs, toMs], у порядку часу; порожні
+    // (метрики не було) пропускаються. resolution - ширина кошиків обраного
+    // рівня: може бути грубшою за granularity, якщо лише грубший рівень
+    // зберігає кошики від fromMs.
+    // false - метрики немає
+    bool query(const std::string &metric, int64_t fromMs, int64_t toMs,
+               std::chrono::milliseconds granularity, std::vector<RollupPoint> &points,
+               std::chrono::milliseconds *resolution = nullptr) const;
+
+    std::vector<std::string> metrics() const;
+    size_t memoryBytes() const;                  // Кошики всіх метрик
+    void clear();
+
+private:
+    struct Bucket {
+        double min;
+        double max;
+        double sum;
+        double last;
+        uint32_t count;
+    };
+
+    struct Level {
+        int64_t resolution_ms = 0;
+        size_t capacity = 0;
+        size_t offset = 0;                       // Початок кільця рівня в Metric::buckets
+        std::vector<int64_t> starts;             // Початок кошика кожного слота
+        size_t head = 0;                         // Слот поточного кошика
+        size_t size = 0;                         // Заповнених слотів
+    };
+
+    struct Metric {
+        std::string name;
+        std::vector<Bucket> buckets;             // Кільця всіх рівнів підряд
+    };
+
+    void advance(Level &level, int64_t timestampMs);
+    void update(const std::string &name, double value);
+    static bool covers(const Level &level, int64_t fromMs);
+    size_t selectLevel(std::chrono::milliseconds granularity, int64_t fromMs) const;
+
+    RollupOptions m_options;
+    size_t m_bucketsPerMetric = 0;
+
+    mutable std::mutex m_mutex;                  // Захищає все нижче
+    std::vector<Level> m_levels;                 // За зростанням resolution
+    std::vector<Metric> m_metrics;
+    std::unordered_map<std::string, size_t> m_metricIndex;
+    bool m_hasSamples = false;
+    int64_t m_lastTimestampMs = 0;
+    std::string m_name;                          // Буфер імені метрики між вибірками
+};
+
+#endif // METRICROLLUP_H
@@ -0,0 +1,68 @@
+#include "MountWatcher.h"
+
+#ifdef __linux__
+#include <cerrno>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#endif
+
+// ========================================
+// Конструктор та деструктор
+// ========================================
+
+MountWatcher::MountWatcher()
+    : m_fd(-1),
+      m_primed(false)
+{
+#ifdef __linux__
+    m_fd = open("/proc/self/mountinfo", O_RDONLY | O_CLOEXEC);
+#endif
+}
+
+MountWatcher::~MountWatcher()
+{
+#ifdef __linux__
+    if (m_fd >= 0)
+        close(m_fd);
+#endif
+}
+
+bool MountWatcher::isValid() const
+{
+    return m_fd >= 0;
+}
+
+// ========================================
+// Очікування змін
+// ========================================
+
+bool MountWatcher::changed(std::chrono::milliseconds timeout)
+{
+    if (!m_primed) {
+        m_primed = true;
+        return true;
+    }
+#ifdef __linux__
+    if (m_fd < 0)
+        return true;
+
+    struct pollfd pfd;
+    pfd.fd = m_fd;
+    pfd.events = POLLPRI;
+    pfd.revents = 0;
+
+    int ready;
+    do {
+        ready = poll(&pfd, 1, static_cast<int>(timeout.count()));
+    } while (ready < 0 && errno == EINTR);
+
+    // Помилка poll - безпечніше вважати, що таблиця змінилась
+    if (ready < 0)
+        return true;
+    return ready > 0 && (pfd.revents & (POLLPRI | POLLERR)) != 0;
+#else
+    (void)timeout;
+    return true;
+#endif
+}
@@ -0,0 +1,32 @@
+#ifndef MOUNTWATCHER_H
+#define MOUNTWATCHER_H
+
+#include <chrono>
+
+// ========================================
+// Клас MountWatcher - зміни таблиці монтування
+// ========================================
+//
+// Ядро позначає відкритий /proc/self/mountinfo як POLLPRI|POLLERR після
+// кожного mount/umount/remount у просторі імен процесу; poll() сам
+// скидає подію, тож файл не потрібно перечитувати. Перший changed()
+// повертає true - знімка ще немає. Якщо mountinfo недоступний (не Linux,
+// без /proc), changed() завжди true, і викликач перелічує томи щоразу.
+class MountWatcher
+{
+public:
+    MountWatcher();
+    ~MountWatcher();
+
+    MountWatcher(const MountWatcher&) = delete;
+    MountWatcher& operator=(const MountWatcher&) = delete;
+
+    bool isValid() const;
+    bool changed(std::chrono::milliseconds timeout = std::chrono::milliseconds(0));
+
+private:
+    int m_fd;
+    bool m_primed;      // Перший changed() уже повернув true
+};
+
+#endif // MOUNTWATCHER_H
@@ -0,0 +1,128 @@
+#include "PressureTrigger.h"
+#include <thread>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#endif
+
+// ========================================
+// Конструктор та деструктор
+// ========================================
+
+PressureTrigger::PressureTrigger()
+{
+}
+
+PressureTrigger::~PressureTrigger()
+{
+    disarm();
+}
+
+// ========================================
+// Налаштування тригерів
+// ========================================
+
+bool PressureTrigger::add(PressureResource resource, bool full,
+                          std::chrono::microseconds stall, std::chrono::microseconds window,
+                          const std::string& cgroupPath)
+{
+#ifdef __linux__
+    const char* name = "cpu";
+    if (resource == PressureResource::Memory) name = "memory";
+    else if (resource == PressureResource::IO) name = "io";
+
+    std::string path = cgroupPath.empty()
+        ? std::string("/proc/pressure/") + name
+        : cgroupPath + "/" + name + ".pressure";
+
+    int fd = open(path.c_str(), O_RDWR | O_NONBLOCK | O_CLOEXEC);
+    if (fd < 0)
+        return false;
+
+    // "some 150000 1000000" - stall та вікно в мікросекундах; ядро чекає і завершальний '\0'
+    char request[64];
+    int length = snprintf(request, sizeof(request), "%s %lld %lld",
+                          full ? "full" : "some",
+                          static_cast<long long>(stall.count()),
+                          static_cast<long long>(window.count()));
+    if (write(fd, request, length + 1) < 0) {
+        close(fd);
+        return false;
+    }
+
+    m_triggers.push_back({ fd, resource });
+    return true;
+#else
+    (void)resource; (void)full; (void)stall; (void)window; (void)cgroupPath;
+    return false;
+#endif
+}
+
+bool PressureTrigger::isArmed() const
+{
+    return !m_triggers.empty();
+}
+
+void PressureTrigger::disarm()
+{
+#ifdef __linux__
+    for (const Trigger& trigger : m_triggers) {
+        close(trigger.fd);
+    }
+#endif
+    m_triggers.clear();
+}
+
+// ========================================
+// Очікування
+// ========================================
+
+std::optional<PressureResource> PressureTrigger::wait(std::chrono::milliseconds timeout)
+{
+#ifdef __linux__
+    if (m_triggers.empty()) {
+        std::this_thread::sleep_for(timeout);
+        return std::nullopt;
+    }
+
+    // Один pollfd на тригер
+    std::vector<struct pollfd> fds(m_triggers.size());
+    const size_t count = fds.size();
+    for (size_t i = 0; i < count; ++i) {
+        fds[i].fd = m_triggers[i].fd;
+        fds[i].events = POLLPRI;
+        fds[i].revents = 0;
+    }
+
+    auto deadline = std::chrono::steady_clock::now() + timeout;
+    while (true) {
+        auto left = std::chrono::duration_cast<std::chrono::milliseconds>(
+            deadline - std::chrono::steady_clock::now());
+        if (left.count() < 0) left = std::chrono::milliseconds(0);
+
+        int ready = poll(fds.data(), count, static_cast<int>(left.count()));
+        if (ready < 0 && errno == EINTR)
+            continue;
+        if (ready <= 0)
+            return std::nullopt;
+
+        for (size_t i = 0; i < count; ++i) {
+            // POLLERR - файл тиску зник (cgroup видалено), тригер більше не спрацює
+            if (fds[i].revents & POLLERR) {
+                fds[i].fd = -1;
+                continue;
+            }
+            if (fds[i].revents & POLLPRI)
+                return m_triggers[i].resource;
+        }
+    }
+#else
+    std::this_thread::sleep_for(timeout);
+    return std::nullopt;
+#endif
+}
@@ -0,0 +1,69 @@
+#ifndef PRESSURETRIGGER_H
+#define PRESSURETRIGGER_H
+
+#include <chrono>
+#include <optional>
+#include <string>
+#include <vector>
+
+// ========================================
+// Ресурс для PSI-тригера
+// ========================================
+enum class PressureResource {
+    CPU,
+    Memory,
+    IO
+};
+
+// ========================================
+// Клас PressureTrigger - будить sampler при stall замість таймера
+// ========================================
+//
+// Використання в циклі вибірок:
+//
+//     PressureTrigger trigger;
+//     trigger.add(PressureResource::Memory, false, 150ms, 2s);  // some 150 ms за 2 s
+//     while (running) {
+//         ArgentumDevice device = hw.getDeviceInfo();
+//         ...
+//         trigger.wait(10s);   // повертається одразу, як тільки stall перевищить поріг
+//     }
+//
+// Обмеження ядра: вікно 500 ms..10 s; без CAP_SYS_RESOURCE - тільки кратне 2 s.
+// Тригер живе, поки відкритий дескриптор (до disarm() або деструктора).
+// Кількість тригерів не обмежена (система та кожна cgroup - до 6: 3 ресурси
+// x some/full); add() повертає false лише якщо ядро відхилило тригер.
+class PressureTrigger
+{
+public:
+    PressureTrigger();
+    ~PressureTrigger();
+
+    PressureTrigger(const PressureTrigger&) = delete;
+    PressureTrigger& operator=(const PressureTrigger&) = delete;
+
+    // ========================================
+    // Налаштування тригерів
+    // ========================================
+    // full = false -> "some", true -> "full"; cgroupPath порожній -> /proc/pressure
+    bool add(PressureResource resource, bool full,
+             std::chrono::microseconds stall, std::chrono::microseconds window,
+             const std::string& cgroupPath = std::string());
+    bool isArmed() const;
+    void disarm();
+
+    // ========================================
+    // Очікування
+    // ========================================
+    // Ресурс, тригер якого спрацював, або nullopt після timeout
+    std::optional<PressureResource> wait(std::chrono::milliseconds timeout);
+
+private:
+    struct Trigger {
+        int fd;
+        PressureResource resource;
+    };
+    std::vector<Trigger> m_triggers;
+};
+
+#endif // PRESSURETRIGGER_H
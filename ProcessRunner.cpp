@@ -0,0 +1,300 @@
+#include "ProcessRunner.h"
+#include <algorithm>
+
+#ifdef __linux__
+#include <cerrno>
+#include <csignal>
+#include <fcntl.h>
+#include <spawn.h>
+#include <sys/epoll.h>
+#include <sys/syscall.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+extern char** environ;
+#endif
+
+namespace {
+
+// Як часто перевіряти isCanceled(), поки утиліта працює
+const int kCancelPollMs = 50;
+
+#ifdef __linux__
+// Інтервал опитування waitpid, якщо ядро без pidfd_open (< 5.3)
+const int kReapPollMs = 5;
+
+int openPidfd(pid_t pid)
+{
+#ifdef SYS_pidfd_open
+    return static_cast<int>(syscall(SYS_pidfd_open, pid, 0));
+#else
+    (void)pid;
+    errno = ENOSYS;
+    return -1;
+#endif
+}
+
+void killAndReap(pid_t pid)
+{
+    kill(pid, SIGKILL);
+    int status = 0;
+    while (waitpid(pid, &status, 0) < 0 && errno == EINTR) {
+    }
+}
+
+// true - процес зібрано (exitCode заповнено)
+bool tryReap(pid_t pid, int& exitCode)
+{
+    int status = 0;
+    pid_t reaped = waitpid(pid, &status, WNOHANG);
+    if (reaped != pid)
+        return false;
+    exitCode = WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+    return true;
+}
+
+// Дочитує все доступне з неблокуючого pipe; false - EOF або помилка
+bool drainPipe(int fd, std::string& output)
+{
+    if (output.capacity() < 4096)
+        output.reserve(4096);
+
+    while (true) {
+        size_t used = output.size();
+        if (used == output.capacity())
+            output.reserve(output.capacity() * 2);
+        output.resize(output.capacity());
+
+        ssize_t n = read(fd, &output[used], output.size() - used);
+        if (n > 0) {
+            output.resize(used + static_cast<size_t>(n));
+            continue;
+        }
+        output.resize(used);
+        if (n < 0 && errno == EINTR) continue;
+        if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) return true;
+        return false;
+    }
+}
+#endif
+
+} // namespace
+
+// ========================================
+// Конструктор та спільний екземпляр
+// ========================================
+
+ProcessRunner::ProcessRunner(size_t maxConcurrent)
+    : m_maxConcurrent(std::max<size_t>(1, maxConcurrent)),
+      m_running(0)
+{
+}
+
+ProcessRunner& ProcessRunner::instance()
+{
+    static ProcessRunner runner;
+    return runner;
+}
+
+// ========================================
+// Обмеження кількості дочірніх процесів
+// ========================================
+
+void ProcessRunner::setMaxConcurrent(size_t maxConcurrent)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_maxConcurrent = std::max<size_t>(1, maxConcurrent);
+    m_slotFreed.notify_all();
+}
+
+size_t ProcessRunner::maxConcurrent() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_maxConcurrent;
+}
+
+size_t ProcessRunner::running() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_running;
+}
+
+bool ProcessRunner::acquireSlot(std::chrono::steady_clock::time_point deadline,
+                                const std::function<bool()>& isCanceled)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (m_running >= m_maxConcurrent) {
+        auto now = std::chrono::steady_clock::now();
+        if (now >= deadline || (isCanceled && isCanceled()))
+            return false;
+
+        auto wakeAt = deadline;
+        if (isCanceled)
+            wakeAt = std::min(wakeAt, now + std::chrono::milliseconds(kCancelPollMs));
+        m_slotFreed.wait_until(lock, wakeAt);
+    }
+    ++m_running;
+    return true;
+}
+
+void ProcessRunner::releaseSlot()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    --m_running;
+    m_slotFreed.notify_one();
+}
+
+const char* ProcessRunner::statusToString(ProcessStatus status)
+{
+    switch (status) {
+    case ProcessStatus::Exited: return "exited";
+    case ProcessStatus::NotFound: return "not found";
+    case ProcessStatus::Timeout: return "timeout";
+    case ProcessStatus::Canceled: return "canceled";
+    default: return "failed";
+    }
+}
+
+// ========================================
+// Запуск
+// ========================================
+
+ProcessResult ProcessRunner::run(const std::string& program, const std::vector<std::string>& arguments,
+                                 std::chrono::milliseconds timeout, std::string& output,
+                                 const std::function<bool()>& isCanceled)
+{
+    ProcessResult result;
+    output.clear();
+
+    auto deadline = std::chrono::steady_clock::now() + timeout;
+    if (!acquireSlot(deadline, isCanceled)) {
+        result.status = (isCanceled && isCanceled()) ? ProcessStatus::Canceled : ProcessStatus::Timeout;
+        return result;
+    }
+
+    struct SlotGuard {
+        ProcessRunner* runner;
+        ~SlotGuard() { runner->releaseSlot(); }
+    } slotGuard{ this };
+
+#ifdef __linux__
+    int pipeFds[2];
+    if (pipe2(pipeFds, O_CLOEXEC) != 0)
+        return result;
+
+    std::vector<char*> argv;
+    argv.reserve(arguments.size() + 2);
+    argv.push_back(const_cast<char*>(program.c_str()));
+    for (const std::string& argument : arguments) {
+        argv.push_back(const_cast<char*>(argument.c_str()));
+    }
+    argv.push_back(nullptr);
+
+    posix_spawn_file_actions_t actions;
+    posix_spawn_file_actions_init(&actions);
+    posix_spawn_file_actions_addopen(&actions, STDIN_FILENO, "/dev/null", O_RDONLY, 0);
+    posix_spawn_file_actions_adddup2(&actions, pipeFds[1], STDOUT_FILENO);
+    posix_spawn_file_actions_addopen(&actions, STDERR_FILENO, "/dev/null", O_WRONLY, 0);
+
+    // Дочірній процес не успадковує заблоковані та проігноровані (SIGPIPE) сигнали
+    posix_spawnattr_t attributes;
+    posix_spawnattr_init(&attributes);
+    sigset_t signals;
+    sigemptyset(&signals);
+    posix_spawnattr_setsigmask(&attributes, &signals);
+    sigaddset(&signals, SIGPIPE);
+    posix_spawnattr_setsigdefault(&attributes, &signals);
+    posix_spawnattr_setflags(&attributes, POSIX_SPAWN_SETSIGMASK | POSIX_SPAWN_SETSIGDEF);
+
+    pid_t pid = -1;
+    int spawnError = posix_spawnp(&pid, program.c_str(), &actions, &attributes, argv.data(), environ);
+    posix_spawn_file_actions_destroy(&actions);
+    posix_spawnattr_destroy(&attributes);
+    close(pipeFds[1]);
+
+    if (spawnError != 0) {
+        close(pipeFds[0]);
+        result.status = (spawnError == ENOENT || spawnError == EACCES || spawnError == ENOEXEC)
+            ? ProcessStatus::NotFound : ProcessStatus::Failed;
+        return result;
+    }
+
+    const int outputFd = pipeFds[0];
+    fcntl(outputFd, F_SETFL, fcntl(outputFd, F_GETFL) | O_NONBLOCK);
+
+    int pidfd = openPidfd(pid);
+    int epollFd = epoll_create1(EPOLL_CLOEXEC);
+    if (epollFd < 0) {
+        killAndReap(pid);
+        if (pidfd >= 0) close(pidfd);
+        close(outputFd);
+        return result;
+    }
+
+    epoll_event event = {};
+    event.events = EPOLLIN;
+    event.data.fd = outputFd;
+    epoll_ctl(epollFd, EPOLL_CTL_ADD, outputFd, &event);
+    if (pidfd >= 0) {
+        event.data.fd = pidfd;
+        epoll_ctl(epollFd, EPOLL_CTL_ADD, pidfd, &event);
+    }
+
+    bool outputOpen = true;
+    bool exited = false;
+    result.status = ProcessStatus::Failed;
+
+    while (outputOpen || !exited) {
+        bool canceled = isCanceled && isCanceled();
+        auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+            deadline - std::chrono::steady_clock::now()).count();
+        if (canceled || remaining <= 0) {
+            // Утиліта вже зібрана, але її нащадок тримає stdout - повертаємо прочитане
+            if (exited) break;
+            killAndReap(pid);
+            exited = true;
+            result.exit_code = -1;
+            result.status = canceled ? ProcessStatus::Canceled : ProcessStatus::Timeout;
+            break;
+        }
+
+        int waitMs = static_cast<int>(remaining);
+        if (isCanceled) waitMs = std::min(waitMs, kCancelPollMs);
+        if (pidfd < 0 && !exited) waitMs = std::min(waitMs, kReapPollMs);
+
+        epoll_event ready[2];
+        int count = epoll_wait(epollFd, ready, 2, waitMs);
+        if (count < 0 && errno != EINTR) {
+            if (!exited) killAndReap(pid);
+            exited = true;
+            break;
+        }
+
+        for (int i = 0; i < count; ++i) {
+            if (ready[i].data.fd == outputFd) {
+                if (!drainPipe(outputFd, output)) {
+                    outputOpen = false;
+                    epoll_ctl(epollFd, EPOLL_CTL_DEL, outputFd, nullptr);
+                }
+            }
+            else if (ready[i].data.fd == pidfd && !exited) {
+                exited = tryReap(pid, result.exit_code);
+                if (exited) epoll_ctl(epollFd, EPOLL_CTL_DEL, pidfd, nullptr);
+            }
+        }
+
+        if (pidfd < 0 && !exited)
+            exited = tryReap(pid, result.exit_code);
+        if (exited && result.status == ProcessStatus::Failed)
+            result.status = ProcessStatus::Exited;
+    }
+
+    close(epollFd);
+    if (pidfd >= 0) close(pidfd);
+    close(outputFd);
+#else
+    (void)program;
+    (void)arguments;
+#endif
+    return result;
+}
@@ -0,0 +1,71 @@
+#ifndef PROCESSRUNNER_H
+#define PROCESSRUNNER_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// ========================================
+// Чим закінчився запуск утиліти
+// ========================================
+enum class ProcessStatus : uint8_t {
+    Exited = 0,        // Завершилась сама (код - у ProcessResult::exit_code)
+    NotFound = 1,      // Утиліти немає в PATH / немає прав на запуск
+    Timeout = 2,       // Не встигла до дедлайну (або не дочекалась слоту) - вбита та зібрана
+    Canceled = 3,      // isCanceled() повернув true - вбита та зібрана
+    Failed = 4         // pipe/spawn/epoll повернули помилку
+};
+
+struct ProcessResult {
+    ProcessStatus status = ProcessStatus::Failed;
+    int exit_code = -1;                 // -1, якщо завершилась сигналом або не запускалась
+};
+
+// ========================================
+// Клас ProcessRunner - запуск утиліт без QProcess
+// ========================================
+//
+// posix_spawnp + pipe для stdout (stdin/stderr -> /dev/null); очікування -
+// epoll на pipe та pidfd дочірнього процесу (Linux 5.3+, інакше - опитування
+// waitpid). На дедлайні або при скасуванні процес отримує SIGKILL і
+// одразу збирається waitpid, тож зомбі не накопичуються. Кількість
+// одночасних дочірніх процесів обмежена; очікування слоту входить у дедлайн.
+// Вивід читається у буфер викликача, ємність якого перевикористовується.
+class ProcessRunner
+{
+public:
+    static constexpr size_t kDefaultMaxConcurrent = 4;
+
+    explicit ProcessRunner(size_t maxConcurrent = kDefaultMaxConcurrent);
+
+    ProcessRunner(const ProcessRunner&) = delete;
+    ProcessRunner& operator=(const ProcessRunner&) = delete;
+
+    // Спільний для всього процесу (обмеження діє на всі провайдери)
+    static ProcessRunner& instance();
+
+    ProcessResult run(const std::string& program, const std::vector<std::string>& arguments,
+                      std::chrono::milliseconds timeout, std::string& output,
+                      const std::function<bool()>& isCanceled = {});
+
+    void setMaxConcurrent(size_t maxConcurrent);
+    size_t maxConcurrent() const;
+    size_t running() const;
+
+    static const char* statusToString(ProcessStatus status);
+
+private:
+    bool acquireSlot(std::chrono::steady_clock::time_point deadline, const std::function<bool()>& isCanceled);
+    void releaseSlot();
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_slotFreed;
+    size_t m_maxConcurrent;
+    size_t m_running;
+};
+
+#endif // PROCESSRUNNER_H
@@ -0,0 +1,371 @@
+#include "ProcessScanner.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+
+#ifdef __linux__
+#include <dirent.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+// Мінімум pid на потік - менші чанки не окуповують створення потоку
+const size_t kMinChunk = 512;
+
+// Мін-купа: на вершині - найменший елемент з топ-N
+template <typename Entry>
+bool heapGreater(const Entry& a, const Entry& b)
+{
+    return a.key > b.key;
+}
+
+template <typename Entry>
+void pushBounded(std::vector<Entry>& heap, size_t limit, const Entry& entry)
+{
+    if (heap.size() < limit) {
+        heap.push_back(entry);
+        std::push_heap(heap.begin(), heap.end(), heapGreater<Entry>);
+    }
+    else if (entry.key > heap.front().key) {
+        std::pop_heap(heap.begin(), heap.end(), heapGreater<Entry>);
+        heap.back() = entry;
+        std::push_heap(heap.begin(), heap.end(), heapGreater<Entry>);
+    }
+}
+
+} // namespace
+
+// ========================================
+// Конструктор та деструктор
+// ========================================
+
+ProcessScanner::ProcessScanner(unsigned threads)
+    : m_threads(threads > 0 ? threads : std::max(1u, std::thread::hardware_concurrency())),
+      m_procFd(-1),
+      m_clockTicks(100),
+      m_pageKb(4),
+      m_lastDuration(0)
+{
+#ifdef __linux__
+    m_procFd = open("/proc", O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    m_clockTicks = sysconf(_SC_CLK_TCK);
+    m_pageKb = sysconf(_SC_PAGESIZE) / 1024;
+#endif
+}
+
+ProcessScanner::~ProcessScanner()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_poolMutex);
+        m_stopping = true;
+    }
+    m_poolWake.notify_all();
+    for (std::thread& worker : m_workers) {
+        worker.join();
+    }
+
+#ifdef __linux__
+    if (m_procFd >= 0) {
+        close(m_procFd);
+    }
+#endif
+}
+
+size_t ProcessScanner::lastProcessCount() const
+{
+    return m_prevSamples.size();
+}
+
+std::chrono::microseconds ProcessScanner::lastScanDuration() const
+{
+    return m_lastDuration;
+}
+
+// ========================================
+// Читання /proc/[pid] - Linux
+// ========================================
+
+#ifdef __linux__
+bool ProcessScanner::readSample(int procFd, int pid, Sample& sample)
+{
+    char path[32];
+    snprintf(path, sizeof(path), "%d/stat", pid);
+    int fd = openat(procFd, path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+        return false;   // Процес завершився між readdir та open
+
+    char buf[1024];
+    ssize_t n = read(fd, buf, sizeof(buf) - 1);
+    close(fd);
+    if (n <= 0)
+        return false;
+    buf[n] = '\0';
+
+    // "pid (comm) state ppid ..." - comm може містити пробіли та дужки
+    const char* open = strchr(buf, '(');
+    const char* close = strrchr(buf, ')');
+    if (!open || !close || close < open || close[1] == '\0')
+        return false;
+
+    size_t commLength = std::min<size_t>(close - open - 1, sizeof(sample.comm) - 1);
+    memcpy(sample.comm, open + 1, commLength);
+    sample.comm[commLength] = '\0';
+
+    const char* p = close + 2;
+    sample.pid = pid;
+    sample.state = *p++;
+
+    // Поля з 4-го (ppid) до 24-го (rss), нумерація як у proc(5)
+    uint64_t utime = 0, stime = 0;
+    for (int field = 4; field <= 24; ++field) {
+        char* end = nullptr;
+        unsigned long long value = strtoull(p, &end, 10);
+        if (end == p)
+            return false;
+        p = end;
+
+        switch (field) {
+        case 4: sample.ppid = static_cast<int>(value); break;
+        case 14: utime = value; break;
+        case 15: stime = value; break;
+        case 20: sample.threads = static_cast<uint32_t>(value); break;
+        case 22: sample.startTime = value; break;
+        case 24: sample.rssPages = value; break;
+        default: break;
+        }
+    }
+    sample.cpuTicks = utime + stime;
+    sample.cpuPercent = -1.0;
+    return true;
+}
+
+bool ProcessScanner::readPssKb(int procFd, int pid, uint64_t& pssKb)
+{
+    char path[32];
+    snprintf(path, sizeof(path), "%d/smaps_rollup", pid);
+    int fd = openat(procFd, path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+        return false;   // Немає прав або ядро < 4.14
+
+    char buf[2048];
+    ssize_t n = read(fd, buf, sizeof(buf) - 1);
+    close(fd);
+    if (n <= 0)
+        return false;
+    buf[n] = '\0';
+
+    const char* pss = strstr(buf, "\nPss:");
+    if (!pss)
+        return false;
+    pssKb = strtoull(pss + 5, nullptr, 10);
+    return true;
+}
+
+void ProcessScanner::listPids()
+{
+    m_pids.clear();
+
+    int dirFd = openat(m_procFd, ".", O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    DIR* dir = dirFd >= 0 ? fdopendir(dirFd) : nullptr;
+    if (!dir) {
+        if (dirFd >= 0) close(dirFd);
+        return;
+    }
+
+    while (struct dirent* entry = readdir(dir)) {
+        if (entry->d_name[0] < '1' || entry->d_name[0] > '9')
+            continue;
+        m_pids.push_back(atoi(entry->d_name));
+    }
+    closedir(dir);
+
+    // readdir віддає pid майже завжди за зростанням - сортування дешеве,
+    // а злиття з попереднім сканом потребує порядку
+    std::sort(m_pids.begin(), m_pids.end());
+}
+
+void ProcessScanner::readChunk(size_t chunk)
+{
+    std::vector<Sample>& out = m_chunks[chunk];
+    out.clear();
+    size_t begin = std::min(m_pids.size(), chunk * m_chunkSize);
+    size_t end = std::min(m_pids.size(), begin + m_chunkSize);
+    Sample sample;
+    for (size_t i = begin; i < end; ++i) {
+        if (readSample(m_procFd, m_pids[i], sample))
+            out.push_back(sample);
+    }
+}
+
+void ProcessScanner::workerLoop(size_t chunk)
+{
+    uint64_t seen = 0;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(m_poolMutex);
+            m_poolWake.wait(lock, [&] { return m_stopping || m_generation != seen; });
+            if (m_stopping)
+                return;
+            seen = m_generation;
+            if (chunk >= m_activeChunks)
+                continue;   // Цей скан обходиться меншою кількістю потоків
+        }
+
+        readChunk(chunk);
+
+        std::lock_guard<std::mutex> lock(m_poolMutex);
+        if (--m_pending == 0)
+            m_poolDone.notify_one();
+    }
+}
+
+void ProcessScanner::collectSamples()
+{
+    size_t total = m_pids.size();
+    size_t threads = std::max<size_t>(1, std::min<size_t>(m_threads, (total + kMinChunk - 1) / kMinChunk));
+    if (m_chunks.size() < threads)
+        m_chunks.resize(threads);
+
+    // Потоки пулу лише додаються: наступні скани з меншим числом процесів
+    // будять їх, але зайві одразу засинають
+    while (m_workers.size() + 1 < threads) {
+        size_t chunk = m_workers.size() + 1;
+        m_workers.emplace_back([this, chunk] { workerLoop(chunk); });
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_poolMutex);
+        m_chunkSize = (total + threads - 1) / threads;
+        m_activeChunks = threads;
+        m_pending = threads - 1;
+        if (m_pending > 0)
+            ++m_generation;
+    }
+    if (threads > 1)
+        m_poolWake.notify_all();
+
+    readChunk(0);
+
+    if (threads > 1) {
+        std::unique_lock<std::mutex> lock(m_poolMutex);
+        m_poolDone.wait(lock, [this] { return m_pending == 0; });
+    }
+
+    // Чанки йдуть за зростанням pid, тож результат лишається відсортованим
+    m_samples.clear();
+    for (size_t t = 0; t < threads; ++t) {
+        m_samples.insert(m_samples.end(), m_chunks[t].begin(), m_chunks[t].end());
+    }
+}
+#endif
+
+ProcessInfo ProcessScanner::toProcessInfo(const Sample& sample) const
+{
+    ProcessInfo info;
+    info.pid = sample.pid;
+    info.ppid = sample.ppid;
+    info.name = sample.comm;
+    info.state = sample.state;
+    info.threads = sample.threads;
+    if (sample.cpuPercent >= 0.0) {
+        info.cpu_percent = sample.cpuPercent;
+    }
+    info.cpu_time_ms = m_clockTicks > 0 ? sample.cpuTicks * 1000 / m_clockTicks : 0;
+    info.rss_kb = sample.rssPages * m_pageKb;
+    return info;
+}
+
+// ========================================
+// Скан
+// ========================================
+
+std::vector<ProcessInfo> ProcessScanner::scan(size_t topN, ProcessSortKey key)
+{
+    std::vector<ProcessInfo> result;
+#ifdef __linux__
+    if (m_procFd < 0 || topN == 0)
+        return result;
+
+    auto start = std::chrono::steady_clock::now();
+    listPids();
+    collectSamples();
+
+    // CPU: злиття двох відсортованих за pid сканів без хеш-таблиць
+    double seconds = std::chrono::duration<double>(start - m_prevScanTime).count();
+    bool haveBaseline = !m_prevSamples.empty() && seconds > 0.0;
+    if (haveBaseline) {
+        size_t j = 0;
+        for (Sample& sample : m_samples) {
+            while (j < m_prevSamples.size() && m_prevSamples[j].pid < sample.pid) ++j;
+
+            uint64_t prevTicks = 0;
+            if (j < m_prevSamples.size() && m_prevSamples[j].pid == sample.pid &&
+                m_prevSamples[j].startTime == sample.startTime &&
+                sample.cpuTicks >= m_prevSamples[j].cpuTicks) {
+                prevTicks = m_prevSamples[j].cpuTicks;
+            }
+            // Новий процес (або pid перевикористано) - весь його час припадає на інтервал
+            sample.cpuPercent = (sample.cpuTicks - prevTicks) * 100.0 / m_clockTicks / seconds;
+        }
+    }
+
+    m_heap.clear();
+    if (key == ProcessSortKey::PSS) {
+        // PSS <= RSS: перебираємо за спаданням RSS і зупиняємось, щойно
+        // RSS наступного кандидата менший за найменший PSS у топ-N
+        m_order.clear();
+        for (size_t i = 0; i < m_samples.size(); ++i) {
+            m_order.push_back(i);
+        }
+        std::sort(m_order.begin(), m_order.end(), [this](size_t a, size_t b) {
+            return m_samples[a].rssPages > m_samples[b].rssPages;
+        });
+
+        for (size_t index : m_order) {
+            uint64_t rssKb = m_samples[index].rssPages * m_pageKb;
+            if (m_heap.size() >= topN && static_cast<double>(rssKb) <= m_heap.front().key)
+                break;
+
+            uint64_t pssKb = 0;
+            if (!readPssKb(m_procFd, m_samples[index].pid, pssKb))
+                continue;
+            pushBounded(m_heap, topN, HeapEntry{ static_cast<double>(pssKb), index, pssKb });
+        }
+    }
+    else {
+        for (size_t i = 0; i < m_samples.size(); ++i) {
+            const Sample& sample = m_samples[i];
+            double value = 0.0;
+            if (key == ProcessSortKey::RSS)
+                value = static_cast<double>(sample.rssPages);
+            else
+                // Перший скан - ранжуємо за сумарним часом CPU
+                value = haveBaseline ? sample.cpuPercent : static_cast<double>(sample.cpuTicks);
+            pushBounded(m_heap, topN, HeapEntry{ value, i, 0 });
+        }
+    }
+
+    std::sort_heap(m_heap.begin(), m_heap.end(), heapGreater<HeapEntry>);
+    result.reserve(m_heap.size());
+    for (const HeapEntry& entry : m_heap) {
+        ProcessInfo info = toProcessInfo(m_samples[entry.index]);
+        if (key == ProcessSortKey::PSS) {
+            info.pss_kb = entry.pssKb;
+        }
+        result.push_back(std::move(info));
+    }
+
+    m_prevSamples.swap(m_samples);
+    m_prevScanTime = start;
+    m_lastDuration = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start);
+#else
+    (void)topN;
+    (void)key;
+#endif
+    return result;
+}
@@ -0,0 +1,117 @@
+#ifndef PROCESSSCANNER_H
+#define PROCESSSCANNER_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+// ========================================
+// Критерій сортування процесів
+// ========================================
+enum class ProcessSortKey : uint8_t {
+    CPU = 0,    // Завантаження CPU між двома сканами
+    RSS = 1,    // Resident Set Size
+    PSS = 2     // Proportional Set Size (smaps_rollup, дорожче)
+};
+
+// ========================================
+// Структура для одного процесу
+// ========================================
+struct ProcessInfo {
+    int pid = 0;
+    int ppid = 0;
+    std::string name;                   // comm, до 15 символів
+    char state = '?';                   // R, S, D, Z ...
+    uint32_t threads = 0;
+    std::optional<double> cpu_percent;  // % одного ядра між сканами (на першому скані немає)
+    uint64_t cpu_time_ms = 0;           // utime + stime з моменту старту
+    uint64_t rss_kb = 0;
+    std::optional<uint64_t> pss_kb;     // Тільки для ProcessSortKey::PSS
+};
+
+// ========================================
+// Клас ProcessScanner - топ-N процесів з /proc/[pid]
+// ========================================
+//
+// Кожен скан читає /proc/[pid]/stat паралельними чанками (utime/stime/rss
+// беруться з одного файлу; statm дублює rss і не читається). Чанки читають
+// потоки власного пулу: створюються при першому скані, якому їх треба, і
+// живуть до деструктора; до 512 pid на потік скан іде в потоці виклику. Для PSS
+// smaps_rollup читається лише для кандидатів з найбільшим RSS, бо PSS <= RSS.
+// Буфери між сканами перевикористовуються; CPU рахується як різниця з
+// попереднім сканом того ж об'єкта. Не потокобезпечний - один сканер на потік.
+class ProcessScanner
+{
+public:
+    explicit ProcessScanner(unsigned threads = 0);   // 0 = hardware_concurrency
+    ~ProcessScanner();
+
+    ProcessScanner(const ProcessScanner&) = delete;
+    ProcessScanner& operator=(const ProcessScanner&) = delete;
+
+    std::vector<ProcessInfo> scan(size_t topN, ProcessSortKey key);
+
+    size_t lastProcessCount() const;                  // Процесів у останньому скані
+    std::chrono::microseconds lastScanDuration() const;
+
+private:
+    // Сирі дані процесу без алокацій (comm - фіксований буфер)
+    struct Sample {
+        int pid;
+        int ppid;
+        char state;
+        char comm[16];
+        uint32_t threads;
+        uint64_t cpuTicks;       // utime + stime
+        uint64_t startTime;      // Для розпізнавання повторного використання pid
+        uint64_t rssPages;
+        double cpuPercent;       // < 0 - немає базової вибірки
+    };
+
+    // Елемент обмеженої мін-купи топ-N
+    struct HeapEntry {
+        double key;
+        size_t index;        // Індекс у m_samples
+        uint64_t pssKb;
+    };
+
+    static bool readSample(int procFd, int pid, Sample& sample);
+    static bool readPssKb(int procFd, int pid, uint64_t& pssKb);
+    void listPids();
+    void collectSamples();
+    void readChunk(size_t chunk);
+    void workerLoop(size_t chunk);
+    ProcessInfo toProcessInfo(const Sample& sample) const;
+
+    unsigned m_threads;
+    int m_procFd;
+    long m_clockTicks;
+    long m_pageKb;
+
+    std::vector<int> m_pids;
+    std::vector<std::vector<Sample>> m_chunks;   // Буфер на кожен потік
+    std::vector<Sample> m_samples;               // Поточний скан, відсортований за pid
+    std::vector<Sample> m_prevSamples;           // Попередній скан
+    std::vector<size_t> m_order;                 // Кандидати для PSS за спаданням RSS
+    std::vector<HeapEntry> m_heap;               // Обмежена купа топ-N
+
+    // Пул читачів чанків: потік i читає чанк i + 1, чанк 0 - потік scan()
+    std::vector<std::thread> m_workers;
+    std::mutex m_poolMutex;                      // Захищає поля пулу нижче
+    std::condition_variable m_poolWake;
+    std::condition_variable m_poolDone;
+    uint64_t m_generation = 0;                   // Номер скану для пулу
+    size_t m_activeChunks = 0;
+    size_t m_chunkSize = 0;
+    size_t m_pending = 0;                        // Чанків пулу, ще не дочитаних
+    bool m_stopping = false;
+    std::chrono::steady_clock::time_point m_prevScanTime;
+    std::chrono::microseconds m_lastDuration;
+};
+
+#endif // PROCESSSCANNER_H
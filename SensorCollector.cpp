@@ -0,0 +1,270 @@
+#include "SensorCollector.h"
+#include "Tracer.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+
+#ifdef __linux__
+#include <dirent.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <climits>
+#endif
+
+#ifdef __linux__
+namespace {
+
+// Вміст невеликого файлу sysfs без кінцевого переводу рядка
+std::string readSysfsString(const std::string& path)
+{
+    std::string value;
+    int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+        return value;
+
+    char buf[256];
+    ssize_t n = read(fd, buf, sizeof(buf));
+    close(fd);
+    if (n > 0) {
+        value.assign(buf, static_cast<size_t>(n));
+        while (!value.empty() && (value.back() == '\n' || value.back() == ' '))
+            value.pop_back();
+    }
+    return value;
+}
+
+// PCI-адреса пристрою, якому належить hwmon ("0000:01:00.0"), або порожній рядок
+std::string pciAddressOf(const std::string& hwmonPath)
+{
+    char resolved[PATH_MAX];
+    if (realpath((hwmonPath + "/device").c_str(), resolved) == nullptr)
+        return std::string();
+
+    const char* name = strrchr(resolved, '/');
+    name = name ? name + 1 : resolved;
+
+    unsigned domain, bus, slot, function;
+    char tail;
+    if (sscanf(name, "%x:%x:%x.%x%c", &domain, &bus, &slot, &function, &tail) != 4)
+        return std::string();
+    return name;
+}
+
+std::vector<std::string> listDirectory(const char* path, const char* prefix)
+{
+    std::vector<std::string> entries;
+    DIR* dir = opendir(path);
+    if (!dir)
+        return entries;
+
+    size_t prefixLength = strlen(prefix);
+    while (struct dirent* entry = readdir(dir)) {
+        if (strncmp(entry->d_name, prefix, prefixLength) == 0)
+            entries.push_back(entry->d_name);
+    }
+    closedir(dir);
+
+    std::sort(entries.begin(), entries.end());
+    return entries;
+}
+
+} // namespace
+#endif
+
+// ========================================
+// Конструктор та деструктор
+// ========================================
+
+SensorCollector::SensorCollector()
+{
+    discover();
+}
+
+SensorCollector::~SensorCollector()
+{
+    closeAll(m_sensors);
+}
+
+void SensorCollector::closeAll(std::vector<Sensor>& sensors)
+{
+#ifdef __linux__
+    for (const Sensor& sensor : sensors) {
+        close(sensor.fd);
+    }
+#endif
+    sensors.clear();
+}
+
+size_t SensorCollector::sensorCount() const
+{
+    std::shared_lock<std::shared_mutex> lock(m_mutex);
+    return m_sensors.size();
+}
+
+std::string SensorCollector::kindUnit(SensorKind kind)
+{
+    switch (kind) {
+    case SensorKind::Temperature: return "C";
+    case SensorKind::Fan: return "RPM";
+    case SensorKind::Voltage: return "V";
+    case SensorKind::Power: return "W";
+    default: return "";
+    }
+}
+
+void SensorCollector::appendMetricName(std::string& out, const SensorReading& reading)
+{
+    out.append(reading.chip);
+    if (!reading.source.empty() && reading.source != reading.chip)
+        out.append("@").append(reading.source);
+    out.append("/").append(reading.label);
+}
+
+// ========================================
+// Пошук сенсорів - Linux
+// ========================================
+
+void SensorCollector::discover()
+{
+    // Скан sysfs - без блокування: читання тим часом ідуть по старому переліку
+    std::vector<Sensor> sensors;
+#ifdef __linux__
+    discoverHwmon(sensors);
+    discoverThermalZones(sensors);
+#endif
+    {
+        std::unique_lock<std::shared_mutex> lock(m_mutex);
+        m_sensors.swap(sensors);
+    }
+    // Старі дескриптори закриваються вже після того, як жодне читання їх не тримає
+    closeAll(sensors);
+}
+
+#ifdef __linux__
+void SensorCollector::discoverHwmon(std::vector<Sensor>& sensors)
+{
+    struct Prefix {
+        const char* name;
+        SensorKind kind;
+        double scale;       // millidegree -> °C, mV -> V, µW -> W
+    };
+    const Prefix prefixes[] = {
+        { "temp", SensorKind::Temperature, 0.001 },
+        { "fan", SensorKind::Fan, 1.0 },
+        { "in", SensorKind::Voltage, 0.001 },
+        { "power", SensorKind::Power, 0.000001 },
+    };
+
+    for (const std::string& hwmon : listDirectory("/sys/class/hwmon", "hwmon")) {
+        std::string hwmonPath = "/sys/class/hwmon/" + hwmon;
+        std::string chip = readSysfsString(hwmonPath + "/name");
+        if (chip.empty()) chip = hwmon;
+        std::string device = pciAddressOf(hwmonPath);
+
+        for (const std::string& file : listDirectory(hwmonPath.c_str(), "")) {
+            // tempN_input, fanN_input, inN_input, powerN_input;
+            // amdgpu та старі драйвери віддають лише powerN_average
+            size_t underscore = file.find('_');
+            if (underscore == std::string::npos)
+                continue;
+            std::string suffix = file.substr(underscore + 1);
+            std::string channel = file.substr(0, underscore);
+
+            for (const Prefix& prefix : prefixes) {
+                size_t prefixLength = strlen(prefix.name);
+                if (channel.compare(0, prefixLength, prefix.name) != 0 ||
+                    channel.size() == prefixLength ||
+                    !isdigit(static_cast<unsigned char>(channel[prefixLength])))
+                    continue;
+
+                bool isInput = suffix == "input";
+                bool isPowerAverage = prefix.kind == SensorKind::Power && suffix == "average" &&
+                    access((hwmonPath + "/" + channel + "_input").c_str(), F_OK) != 0;
+                if (!isInput && !isPowerAverage)
+                    break;
+
+                int fd = open((hwmonPath + "/" + file).c_str(), O_RDONLY | O_CLOEXEC);
+                if (fd < 0)
+                    break;
+
+                Sensor sensor;
+                sensor.fd = fd;
+                sensor.scale = prefix.scale;
+                sensor.reading.chip = chip;
+                sensor.reading.label = readSysfsString(hwmonPath + "/" + channel + "_label");
+                if (sensor.reading.label.empty()) sensor.reading.label = channel;
+                sensor.reading.device = device;
+                sensor.reading.source = hwmon;
+                sensor.reading.kind = prefix.kind;
+                sensors.push_back(sensor);
+                break;
+            }
+        }
+    }
+}
+
+void SensorCollector::discoverThermalZones(std::vector<Sensor>& sensors)
+{
+    for (const std::string& zone : listDirectory("/sys/class/thermal", "thermal_zone")) {
+        std::string zonePath = "/sys/class/thermal/" + zone;
+        int fd = open((zonePath + "/temp").c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0)
+            continue;
+
+        Sensor sensor;
+        sensor.fd = fd;
+        sensor.scale = 0.001;
+        sensor.reading.chip = zone;
+        sensor.reading.source = zone;
+        sensor.reading.label = readSysfsString(zonePath + "/type");
+        sensor.reading.kind = SensorKind::Temperature;
+        sensors.push_back(sensor);
+    }
+}
+#endif
+
+// ========================================
+// Читання значень
+// ========================================
+
+std::vector<SensorReading> SensorCollector::read() const
+{
+    std::vector<SensorReading> readings;
+    readInto(readings);
+    return readings;
+}
+
+void SensorCollector::readInto(std::vector<SensorReading>& readings) const
+{
+    size_t count = 0;
+#ifdef __linux__
+    std::shared_lock<std::shared_mutex> lock(m_mutex);
+    for (const Sensor& sensor : m_sensors) {
+        // sysfs перегенеровує значення при читанні з нульового зміщення
+        char buf[32];
+        TraceSpan span("file", "pread", sensor.reading.chip.c_str());
+        ssize_t n = pread(sensor.fd, buf, sizeof(buf) - 1, 0);
+        if (n <= 0)
+            continue;   // ENODATA/EIO - сенсор зараз недоступний (напр. GPU у D3cold)
+        buf[n] = '\0';
+
+        char* end = nullptr;
+        long long raw = strtoll(buf, &end, 10);
+        if (end == buf)
+            continue;
+
+        if (count == readings.size())
+            readings.emplace_back();
+        SensorReading& reading = readings[count++];
+        reading.chip.assign(sensor.reading.chip);
+        reading.label.assign(sensor.reading.label);
+        reading.device.assign(sensor.reading.device);
+        reading.source.assign(sensor.reading.source);
+        reading.kind = sensor.reading.kind;
+        reading.value = raw * sensor.scale;
+    }
+#endif
+    readings.resize(count);
+}
@@ -0,0 +1,77 @@
+#ifndef SENSORCOLLECTOR_H
+#define SENSORCOLLECTOR_H
+
+#include <cstdint>
+#include <shared_mutex>
+#include <string>
+#include <vector>
+
+// ========================================
+// Тип сенсора
+// ========================================
+enum class SensorKind : uint8_t {
+    Temperature = 0,    // °C
+    Fan = 1,            // RPM
+    Voltage = 2,        // V
+    Power = 3           // W
+};
+
+// ========================================
+// Структура для одного показника сенсора
+// ========================================
+struct SensorReading {
+    std::string chip;       // coretemp, nvme, amdgpu, thermal_zone0
+    std::string label;      // "Package id 0", "Composite", "edge", "x86_pkg_temp"
+    std::string device;     // PCI-адреса пристрою (0000:01:00.0), якщо сенсор належить PCI-пристрою
+    std::string source;     // hwmon3, thermal_zone0 - каталог sysfs; розрізняє однакові chip/label
+    SensorKind kind = SensorKind::Temperature;
+    double value = 0.0;     // В одиницях SensorKind
+};
+
+// ========================================
+// Клас SensorCollector - hwmon та thermal zones
+// ========================================
+//
+// Каталоги /sys/class/hwmon/hwmon*/{temp,fan,in,power}*_input та
+// /sys/class/thermal/thermal_zone* скануються у конструкторі та в discover();
+// дескриптори файлів значень лишаються відкритими, і кожна вибірка робить
+// лише pread() на них. Потокобезпечний: читання йдуть паралельно під
+// спільним блокуванням, discover() сканує sysfs без блокування і лише
+// підміняє перелік під винятковим. Після hotplug - викликати discover().
+class SensorCollector
+{
+public:
+    SensorCollector();
+    ~SensorCollector();
+
+    SensorCollector(const SensorCollector&) = delete;
+    SensorCollector& operator=(const SensorCollector&) = delete;
+
+    void discover();
+    size_t sensorCount() const;
+
+    std::vector<SensorReading> read() const;
+    void readInto(std::vector<SensorReading>& readings) const;  // Перевикористовує рядки та ємність
+
+    static std::string kindUnit(SensorKind kind);
+
+    // Унікальне ім'я сенсора для метрик: "nvme@hwmon3/Composite", "thermal_zone0/acpitz".
+    // Самі chip/label повторюються - два NVMe, coretemp двох сокетів
+    static void appendMetricName(std::string& out, const SensorReading& reading);
+
+private:
+    struct Sensor {
+        int fd;
+        double scale;             // Сире значення * scale = одиниці SensorKind
+        SensorReading reading;    // Метадані (chip/label/device/source/kind)
+    };
+
+    static void closeAll(std::vector<Sensor>& sensors);
+    static void discoverHwmon(std::vector<Sensor>& sensors);
+    static void discoverThermalZones(std::vector<Sensor>& sensors);
+
+    mutable std::shared_mutex m_mutex;     // Захищає m_sensors: читання - спільно, заміна - винятково
+    std::vector<Sensor> m_sensors;
+};
+
+#endif // SENSORCOLLECTOR_H
@@ -0,0 +1,467 @@
+#include "SeriesCodec.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace {
+
+unsigned countLeadingZeros(uint64_t value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return value == 0 ? 64 : static_cast<unsigned>(__builtin_clzll(value));
+#else
+    unsigned count = 0;
+    for (uint64_t mask = uint64_t(1) << 63; mask != 0 && !(value & mask); mask >>= 1)
+        ++count;
+    return count;
+#endif
+}
+
+unsigned countTrailingZeros(uint64_t value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return value == 0 ? 64 : static_cast<unsigned>(__builtin_ctzll(value));
+#else
+    unsigned count = 0;
+    for (uint64_t mask = 1; mask != 0 && !(value & mask); mask <<= 1)
+        ++count;
+    return count;
+#endif
+}
+
+uint64_t doubleBits(double value)
+{
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+double bitsDouble(uint64_t bits)
+{
+    double value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+uint64_t zigzag(uint64_t value)
+{
+    return (value << 1) ^ (0 - (value >> 63));
+}
+
+uint64_t unzigzag(uint64_t value)
+{
+    return (value >> 1) ^ (0 - (value & 1));
+}
+
+// Префікс (кількість одиниць перед нулем) -> ширина значення
+const unsigned kDeltaWidths[] = { 0, 7, 9, 12, 32, 64 };
+
+int64_t toInteger(const std::optional<uint64_t>& value)
+{
+    return value.has_value() ? static_cast<int64_t>(value.value()) : SampleSeries::kMissingInteger;
+}
+
+double toDouble(const std::optional<double>& value)
+{
+    return value.value_or(std::numeric_limits<double>::quiet_NaN());
+}
+
+} // namespace
+
+// ========================================
+// BitWriter / BitReader
+// ========================================
+
+void BitWriter::write(uint64_t bits, unsigned count)
+{
+    while (count > 0) {
+        const unsigned used = static_cast<unsigned>(m_bitCount & 7);
+        if (used == 0)
+            m_bytes.push_back(0);
+
+        const unsigned take = std::min(8 - used, count);
+        const unsigned chunk = static_cast<unsigned>(bits >> (count - take)) & ((1u << take) - 1);
+        m_bytes.back() |= static_cast<uint8_t>(chunk << (8 - used - take));
+        count -= take;
+        m_bitCount += take;
+    }
+}
+
+void BitWriter::clear()
+{
+    m_bytes.clear();
+    m_bitCount = 0;
+}
+
+BitReader::BitReader(const uint8_t* data, size_t size)
+    : m_data(data),
+      m_bitCount(static_cast<uint64_t>(size) * 8)
+{
+}
+
+bool BitReader::read(unsigned count, uint64_t& bits)
+{
+    if (m_bitCount - m_position < count)
+        return false;
+
+    uint64_t value = 0;
+    while (count > 0) {
+        const unsigned used = static_cast<unsigned>(m_position & 7);
+        const unsigned take = std::min(8 - used, count);
+        const unsigned chunk = (m_data[m_position >> 3] >> (8 - used - take)) & ((1u << take) - 1);
+        value = (take == 64 ? 0 : value << take) | chunk;
+        count -= take;
+        m_position += take;
+    }
+    bits = value;
+    return true;
+}
+
+bool BitReader::readBit(bool& bit)
+{
+    if (m_position >= m_bitCount)
+        return false;
+    bit = (m_data[m_position >> 3] >> (7 - (m_position & 7))) & 1;
+    ++m_position;
+    return true;
+}
+
+// ========================================
+// IntegerSeriesEncoder / IntegerSeriesDecoder
+// ========================================
+
+void IntegerSeriesEncoder::append(int64_t value)
+{
+    if (m_count == 0) {
+        m_bits.write(static_cast<uint64_t>(value), 64);
+    } else {
+        // Беззнакова арифметика: переповнення різниць визначене і зворотне
+        const uint64_t delta = static_cast<uint64_t>(value) - static_cast<uint64_t>(m_previous);
+        const uint64_t encoded = zigzag(delta - static_cast<uint64_t>(m_previousDelta));
+
+        if (encoded == 0) {
+            m_bits.write(0, 1);
+        } else if (encoded < (uint64_t(1) << 7)) {
+            m_bits.write(0x2, 2);
+            m_bits.write(encoded, 7);
+        } else if (encoded < (uint64_t(1) << 9)) {
+            m_bits.write(0x6, 3);
+            m_bits.write(encoded, 9);
+        } else if (encoded < (uint64_t(1) << 12)) {
+            m_bits.write(0xE, 4);
+            m_bits.write(encoded, 12);
+        } else if (encoded < (uint64_t(1) << 32)) {
+            m_bits.write(0x1E, 5);
+            m_bits.write(encoded, 32);
+        } else {
+            m_bits.write(0x1F, 5);
+            m_bits.write(encoded, 64);
+        }
+        m_previousDelta = static_cast<int64_t>(delta);
+    }
+    m_previous = value;
+    ++m_count;
+}
+
+void IntegerSeriesEncoder::clear()
+{
+    m_bits.clear();
+    m_count = 0;
+    m_previous = 0;
+    m_previousDelta = 0;
+}
+
+IntegerSeriesDecoder::IntegerSeriesDecoder(const uint8_t* data, size_t size, size_t count)
+    : m_bits(data, size),
+      m_remaining(count)
+{
+}
+
+bool IntegerSeriesDecoder::next(int64_t& value)
+{
+    if (m_remaining == 0)
+        return false;
+
+    uint64_t bits = 0;
+    if (m_decoded == 0) {
+        if (!m_bits.read(64, bits))
+            return false;
+        m_previous = static_cast<int64_t>(bits);
+    } else {
+        unsigned prefix = 0;
+        bool bit = false;
+        while (prefix < 5) {
+            if (!m_bits.readBit(bit))
+                return false;
+            if (!bit)
+                break;
+            ++prefix;
+        }
+
+        uint64_t encoded = 0;
+        if (prefix > 0 && !m_bits.read(kDeltaWidths[prefix], encoded))
+            return false;
+
+        const uint64_t delta = static_cast<uint64_t>(m_previousDelta) + unzigzag(encoded);
+        m_previousDelta = static_cast<int64_t>(delta);
+        m_previous = static_cast<int64_t>(static_cast<uint64_t>(m_previous) + delta);
+    }
+
+    value = m_previous;
+    ++m_decoded;
+    --m_remaining;
+    return true;
+}
+
+// ========================================
+// DoubleSeriesEncoder / DoubleSeriesDecoder
+// ========================================
+
+void DoubleSeriesEncoder::append(double value)
+{
+    const uint64_t bits = doubleBits(value);
+    if (m_count == 0) {
+        m_bits.write(bits, 64);
+    } else {
+        const uint64_t xored = bits ^ m_previous;
+        if (xored == 0) {
+            m_bits.write(0, 1);
+        } else {
+            // 5 бітів на нулі зліва - більше 31 не кодується
+            const unsigned leading = std::min(countLeadingZeros(xored), 31u);
+            const unsigned trailing = countTrailingZeros(xored);
+
+            if (m_hasWindow && leading >= m_leading && trailing >= m_trailing) {
+                m_bits.write(0x2, 2);
+                m_bits.write(xored >> m_trailing, 64 - m_leading - m_trailing);
+            } else {
+                const unsigned meaningful = 64 - leading - trailing;
+                m_bits.write(0x3, 2);
+                m_bits.write(leading, 5);
+                m_bits.write(meaningful - 1, 6);
+                m_bits.write(xored >> trailing, meaningful);
+                m_leading = leading;
+                m_trailing = trailing;
+                m_hasWindow = true;
+            }
+        }
+    }
+    m_previous = bits;
+    ++m_count;
+}
+
+void DoubleSeriesEncoder::clear()
+{
+    m_bits.clear();
+    m_count = 0;
+    m_previous = 0;
+    m_leading = 0;
+    m_trailing = 0;
+    m_hasWindow = false;
+}
+
+DoubleSeriesDecoder::DoubleSeriesDecoder(const uint8_t* data, size_t size, size_t count)
+    : m_bits(data, size),
+      m_remaining(count)
+{
+}
+
+bool DoubleSeriesDecoder::next(double& value)
+{
+    if (m_remaining == 0)
+        return false;
+
+    uint64_t bits = 0;
+    if (m_decoded == 0) {
+        if (!m_bits.read(64, bits))
+            return false;
+        m_previous = bits;
+    } else {
+        bool changed = false;
+        if (!m_bits.readBit(changed))
+            return false;
+
+        if (changed) {
+            bool newWindow = false;
+            if (!m_bits.readBit(newWindow))
+                return false;
+
+            if (newWindow) {
+                uint64_t leading = 0;
+                uint64_t meaningful = 0;
+                if (!m_bits.read(5, leading) || !m_bits.read(6, meaningful))
+                    return false;
+                if (leading + meaningful + 1 > 64)
+                    return false;
+                m_leading = static_cast<unsigned>(leading);
+                m_trailing = 64 - m_leading - static_cast<unsigned>(meaningful + 1);
+                m_hasWindow = true;
+            } else if (!m_hasWindow) {
+                // Вікна ще не було - пошкоджений потік
+                return false;
+            }
+
+            uint64_t xored = 0;
+            if (!m_bits.read(64 - m_leading - m_trailing, xored))
+                return false;
+            m_previous ^= xored << m_trailing;
+        }
+    }
+
+    value = bitsDouble(m_previous);
+    ++m_decoded;
+    --m_remaining;
+    return true;
+}
+
+// ========================================
+// SampleSeries
+// ========================================
+
+void SampleSeries::append(int64_t timestampMs, const ArgentumDevice& device)
+{
+    m_timestamps.append(timestampMs);
+    std::fill(m_written.begin(), m_written.end(), 0);
+
+    put("ram_used_mb", toInteger(device.ram_used_mb));
+    put("ram_available_mb", toInteger(device.ram_available_mb));
+    put("ram_usage_percent", toDouble(device.ram_usage_percent));
+    put("free_disk_mb", toInteger(device.free_disk_mb));
+    put("package_power_w", toDouble(device.package_power_w));
+
+    for (const DiskInfo& disk : device.disks) {
+        putKeyed("disk:", disk.mount_point, ":free_mb", static_cast<int64_t>(disk.free_mb));
+        putKeyed("disk:", disk.mount_point, ":usage_percent", disk.usage_percent);
+    }
+    for (size_t i = 0; i < device.gpus.size(); ++i) {
+        const GPUInfo& gpu = device.gpus[i];
+        // Без PCI-адреси (Windows) - модель з номером у списку
+        const std::string& key = gpu.pci_address.empty() ? gpu.model + "#" + std::to_string(i) : gpu.pci_address;
+        putKeyed("gpu:", key, ":vram_used_mb", toInteger(gpu.vram_used_mb));
+    }
+    for (const NetInterfaceInfo& nic : device.network) {
+        putKeyed("net:", nic.name, ":rx_bytes", static_cast<int64_t>(nic.rx_bytes));
+        putKeyed("net:", nic.name, ":tx_bytes", static_cast<int64_t>(nic.tx_bytes));
+    }
+    for (const PowerDomainInfo& domain : device.power_domains) {
+        putKeyed("power:", domain.zone, ":energy_uj", static_cast<int64_t>(domain.energy_uj));
+    }
+    for (const SensorReading& sensor : device.sensors) {
+        m_name.assign("sensor:");
+        SensorCollector::appendMetricName(m_name, sensor);
+        putCurrent(sensor.value);
+    }
+
+    // Пристрої, яких немає в цій вибірці
+    for (size_t i = 0; i < m_columns.size(); ++i) {
+        if (m_written[i])
+            continue;
+        Column& missing = m_columns[i];
+        if (missing.integer)
+            missing.integers.append(kMissingInteger);
+        else
+            missing.doubles.append(std::numeric_limits<double>::quiet_NaN());
+    }
+}
+
+void SampleSeries::clear()
+{
+    m_timestamps.clear();
+    m_columns.clear();
+    m_columnIndex.clear();
+    m_written.clear();
+}
+
+size_t SampleSeries::sampleCount() const
+{
+    return m_timestamps.count();
+}
+
+size_t SampleSeries::sizeBytes() const
+{
+    size_t total = m_timestamps.sizeBytes();
+    for (const Column& c : m_columns)
+        total += c.sizeBytes();
+    return total;
+}
+
+uint64_t SampleSeries::valueCount() const
+{
+    uint64_t total = 0;
+    for (const Column& c : m_columns)
+        total += c.count();
+    return total;
+}
+
+const IntegerSeriesEncoder& SampleSeries::timestamps() const
+{
+    return m_timestamps;
+}
+
+const std::vector<SampleSeries::Column>& SampleSeries::columns() const
+{
+    return m_columns;
+}
+
+SampleSeries::Column& SampleSeries::column(const std::string& name, bool integer)
+{
+    auto it = m_columnIndex.find(name);
+    if (it != m_columnIndex.end())
+        return m_columns[it->second];
+
+    // Нова колонка - з поточної вибірки (мітка часу вже дописана)
+    m_columnIndex.emplace(name, m_columns.size());
+    m_columns.emplace_back();
+    m_written.push_back(0);
+    Column& created = m_columns.back();
+    created.name = name;
+    created.integer = integer;
+    created.first_sample = m_timestamps.count() - 1;
+    return created;
+}
+
+void SampleSeries::put(const char* name, int64_t value)
+{
+    m_name.assign(name);
+    putCurrent(value);
+}
+
+void SampleSeries::put(const char* name, double value)
+{
+    m_name.assign(name);
+    putCurrent(value);
+}
+
+void SampleSeries::putKeyed(const char* prefix, const std::string& key, const char* field, int64_t value)
+{
+    m_name.assign(prefix).append(key).append(field);
+    putCurrent(value);
+}
+
+void SampleSeries::putKeyed(const char* prefix, const std::string& key, const char* field, double value)
+{
+    m_name.assign(prefix).append(key).append(field);
+    putCurrent(value);
+}
+
+void SampleSeries::putCurrent(int64_t value)
+{
+    Column& c = column(m_name, true);
+    const size_t index = static_cast<size_t>(&c - m_columns.data());
+    // Повторний ключ у тій самій вибірці (два томи з однаковою точкою) - лише перший
+    if (m_written[index] || !c.integer)
+        return;
+    c.integers.append(value);
+    m_written[index] = 1;
+}
+
+void SampleSeries::putCurrent(double value)
+{
+    Column& c = column(m_name, false);
+    const size_t index = static_cast<size_t>(&c - m_columns.data());
+    if (m_written[index] || c.integer)
+        return;
+    c.doubles.append(value);
+    m_written[index] = 1;
+}
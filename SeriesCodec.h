@@ -0,0 +1,179 @@
+#ifndef SERIESCODEC_H
+#define SERIESCODEC_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "DeviceInfo.h"
+
+// ========================================
+// Бітовий потік (старший біт першим)
+// ========================================
+class BitWriter
+{
+public:
+    void write(uint64_t bits, unsigned count);    // Молодші count (1..64) бітів
+    void clear();
+
+    const uint8_t* data() const { return m_bytes.data(); }
+    size_t sizeBytes() const { return m_bytes.size(); }
+    uint64_t sizeBits() const { return m_bitCount; }
+
+private:
+    std::vector<uint8_t> m_bytes;                  // Останній байт доповнено нулями
+    uint64_t m_bitCount = 0;
+};
+
+class BitReader
+{
+public:
+    BitReader(const uint8_t* data, size_t size);
+
+    bool read(unsigned count, uint64_t& bits);     // false - потік закінчився
+    bool readBit(bool& bit);
+
+private:
+    const uint8_t* m_data;
+    uint64_t m_bitCount;
+    uint64_t m_position = 0;
+};
+
+// ========================================
+// Delta-of-delta для міток часу та цілих лічильників
+// ========================================
+//
+// Перше значення - 64 біти, далі zigzag різниці різниць префіксним кодом:
+// '0' (рівний крок), '10'+7, '110'+9, '1110'+12, '11110'+32, '11111'+64 біти.
+// Вибірки з постійним інтервалом коштують 1 біт на мітку часу.
+class IntegerSeriesEncoder
+{
+public:
+    void append(int64_t value);
+    void clear();
+
+    size_t count() const { return m_count; }
+    const uint8_t* data() const { return m_bits.data(); }
+    size_t sizeBytes() const { return m_bits.sizeBytes(); }
+
+private:
+    BitWriter m_bits;
+    size_t m_count = 0;
+    int64_t m_previous = 0;
+    int64_t m_previousDelta = 0;
+};
+
+class IntegerSeriesDecoder
+{
+public:
+    // count - кількість значень (IntegerSeriesEncoder::count())
+    IntegerSeriesDecoder(const uint8_t* data, size_t size, size_t count);
+
+    bool next(int64_t& value);                     // false - значення скінчились або потік пошкоджено
+
+private:
+    BitReader m_bits;
+    size_t m_remaining;
+    size_t m_decoded = 0;
+    int64_t m_previous = 0;
+    int64_t m_previousDelta = 0;
+};
+
+// ========================================
+// XOR-кодування double (Gorilla)
+// ========================================
+//
+// Перше значення - 64 біти. Далі XOR з попереднім: '0' - те саме значення;
+// '10' - значущі біти у вікні попереднього XOR; '11' + 5 бітів нулів зліва
+// + 6 бітів довжини + значущі біти - нове вікно. NaN (відсутнє значення)
+// кодується як будь-яке інше.
+class DoubleSeriesEncoder
+{
+public:
+    void append(double value);
+    void clear();
+
+    size_t count() const { return m_count; }
+    const uint8_t* data() const { return m_bits.data(); }
+    size_t sizeBytes() const { return m_bits.sizeBytes(); }
+
+private:
+    BitWriter m_bits;
+    size_t m_count = 0;
+    uint64_t m_previous = 0;
+    unsigned m_leading = 0;
+    unsigned m_trailing = 0;
+    bool m_hasWindow = false;
+};
+
+class DoubleSeriesDecoder
+{
+public:
+    DoubleSeriesDecoder(const uint8_t* data, size_t size, size_t count);
+
+    bool next(double& value);
+
+private:
+    BitReader m_bits;
+    size_t m_remaining;
+    size_t m_decoded = 0;
+    uint64_t m_previous = 0;
+    unsigned m_leading = 0;
+    unsigned m_trailing = 0;
+    bool m_hasWindow = false;
+};
+
+// ========================================
+// Клас SampleSeries - числові поля вибірок ArgentumDevice по колонках
+// ========================================
+//
+// Кожна метрика - окрема колонка зі своїм кодувальником: цілі (МБ, лічильники
+// байтів та енергії) - delta-of-delta, дробові (відсотки, сенсори, потужність) -
+// XOR. Колонки дисків, GPU, інтерфейсів, доменів RAPL та сенсорів називаються
+// за ключем пристрою ("disk:/home:free_mb") і з'являються з першої вибірки,
+// де пристрій є; first_sample - її номер. У вибірках без пристрою чи значення
+// колонка отримує kMissingInteger або NaN.
+class SampleSeries
+{
+public:
+    static constexpr int64_t kMissingInteger = INT64_MIN;
+
+    struct Column {
+        std::string name;
+        bool integer = false;
+        size_t first_sample = 0;
+        IntegerSeriesEncoder integers;            // integer == true
+        DoubleSeriesEncoder doubles;              // integer == false
+
+        size_t count() const { return integer ? integers.count() : doubles.count(); }
+        size_t sizeBytes() const { return integer ? integers.sizeBytes() : doubles.sizeBytes(); }
+    };
+
+    void append(int64_t timestampMs, const ArgentumDevice& device);
+    void clear();
+
+    size_t sampleCount() const;
+    size_t sizeBytes() const;                       // Усі колонки разом з мітками часу
+    uint64_t valueCount() const;                    // Закодовані значення без міток часу
+
+    const IntegerSeriesEncoder& timestamps() const;
+    const std::vector<Column>& columns() const;
+
+private:
+    Column& column(const std::string& name, bool integer);
+    void put(const char* name, int64_t value);
+    void put(const char* name, double value);
+    void putKeyed(const char* prefix, const std::string& key, const char* field, int64_t value);
+    void putKeyed(const char* prefix, const std::string& key, const char* field, double value);
+    void putCurrent(int64_t value);                 // У колонку з іменем m_name
+    void putCurrent(double value);
+
+    IntegerSeriesEncoder m_timestamps;
+    std::vector<Column> m_columns;
+    std::unordered_map<std::string, size_t> m_columnIndex;
+    std::vector<uint8_t> m_written;                 // Колонка вже отримала значення цієї вибірки
+    std::string m_name;                             // Буфер імені колонки між вибірками
+};
+
+#endif // SERIESCODEC_H
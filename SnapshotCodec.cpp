@@ -0,0 +1,479 @@
+#include "SnapshotCodec.h"
+#include <cstring>
+
+namespace {
+
+// ========================================
+// Запис
+// ========================================
+
+class Writer
+{
+public:
+    explicit Writer(std::string& out) : m_out(out) {}
+
+    template <typename T>
+    void raw(T value)
+    {
+        char bytes[sizeof(T)];
+        memcpy(bytes, &value, sizeof(T));
+        m_out.append(bytes, sizeof(T));
+    }
+
+    void put(uint8_t value) { raw(value); }
+    void put(uint32_t value) { raw(value); }
+    void put(uint64_t value) { raw(value); }
+    void put(double value) { raw(value); }
+    void put(DiskType value) { raw(static_cast<uint8_t>(value)); }
+    void put(SensorKind value) { raw(static_cast<uint8_t>(value)); }
+
+    void put(const std::string& value)
+    {
+        raw(static_cast<uint32_t>(value.size()));
+        m_out.append(value);
+    }
+
+    template <typename T>
+    void put(const std::optional<T>& value)
+    {
+        raw(static_cast<uint8_t>(value.has_value()));
+        if (value.has_value()) put(value.value());
+    }
+
+    template <typename T>
+    void put(const std::vector<T>& values)
+    {
+        raw(static_cast<uint32_t>(values.size()));
+        for (const T& value : values) put(value);
+    }
+
+    void put(const PressureStats& stats)
+    {
+        put(stats.avg10);
+        put(stats.avg60);
+        put(stats.avg300);
+        put(stats.total_us);
+    }
+
+    void put(const PressureInfo& info)
+    {
+        put(info.some);
+        put(info.full);
+    }
+
+    void put(const SystemPressure& pressure)
+    {
+        put(pressure.cpu);
+        put(pressure.memory);
+        put(pressure.io);
+    }
+
+    void put(const CgroupLimits& limits)
+    {
+        put(limits.path);
+        put(limits.cpu_quota_us);
+        put(limits.cpu_period_us);
+        put(limits.cpu_quota_cores);
+        put(limits.cpuset_cpus);
+        put(limits.memory_max_mb);
+        put(limits.memory_high_mb);
+        put(limits.memory_current_mb);
+    }
+
+    void put(const SensorReading& sensor)
+    {
+        put(sensor.chip);
+        put(sensor.label);
+        put(sensor.device);
+        put(sensor.source);
+        put(sensor.kind);
+        put(sensor.value);
+    }
+
+    void put(const GPUInfo& gpu)
+    {
+        put(gpu.model);
+        put(gpu.vram_mb);
+        put(gpu.vram_used_mb);
+        put(gpu.vram_free_mb);
+        put(gpu.vram_usage_percent);
+        put(gpu.pci_address);
+        put(gpu.sensors);
+    }
+
+    void put(const DiskIOStats& io)
+    {
+        put(io.device);
+        put(io.reads_completed);
+        put(io.writes_completed);
+        put(io.read_bytes);
+        put(io.write_bytes);
+        put(io.in_flight);
+        put(io.read_mb_per_sec);
+        put(io.write_mb_per_sec);
+        put(io.read_iops);
+        put(io.write_iops);
+        put(io.await_ms);
+        put(io.avg_queue_depth);
+        put(io.util_percent);
+    }
+
+    void put(const DiskInfo& disk)
+    {
+        put(disk.mount_point);
+        put(disk.filesystem);
+        put(disk.type);
+        put(disk.total_mb);
+        put(disk.free_mb);
+        put(disk.used_mb);
+        put(disk.usage_percent);
+        put(disk.free_percent);
+        put(disk.block_device);
+        put(disk.io);
+    }
+
+    void put(const NetInterfaceInfo& nic)
+    {
+        put(nic.name);
+        put(nic.speed_mbps);
+        put(nic.mtu);
+        put(nic.rx_bytes);
+        put(nic.rx_packets);
+        put(nic.rx_errors);
+        put(nic.rx_drops);
+        put(nic.tx_bytes);
+        put(nic.tx_packets);
+        put(nic.tx_errors);
+        put(nic.tx_drops);
+        put(nic.rx_mb_per_sec);
+        put(nic.tx_mb_per_sec);
+        put(nic.rx_packets_per_sec);
+        put(nic.tx_packets_per_sec);
+        put(nic.rx_errors_per_sec);
+        put(nic.tx_errors_per_sec);
+        put(nic.rx_drops_per_sec);
+        put(nic.tx_drops_per_sec);
+        put(nic.link_usage_percent);
+    }
+
+    void put(const PowerDomainInfo& domain)
+    {
+        put(domain.zone);
+        put(domain.name);
+        put(domain.energy_uj);
+        put(domain.power_w);
+    }
+
+private:
+    std::string& m_out;
+};
+
+// ========================================
+// Читання
+// ========================================
+
+class Reader
+{
+public:
+    Reader(const char* data, size_t size) : m_pos(data), m_end(data + size) {}
+
+    bool ok() const { return m_ok; }
+    bool atEnd() const { return m_pos == m_end; }
+    void setVersion(uint8_t version) { m_version = version; }
+
+    template <typename T>
+    void raw(T& value)
+    {
+        if (!m_ok || static_cast<size_t>(m_end - m_pos) < sizeof(T)) {
+            m_ok = false;
+            value = T();
+            return;
+        }
+        memcpy(&value, m_pos, sizeof(T));
+        m_pos += sizeof(T);
+    }
+
+    void get(uint8_t& value) { raw(value); }
+    void get(uint32_t& value) { raw(value); }
+    void get(uint64_t& value) { raw(value); }
+    void get(double& value) { raw(value); }
+
+    void get(DiskType& value)
+    {
+        uint8_t code = 0;
+        raw(code);
+        value = static_cast<DiskType>(code);
+    }
+
+    void get(SensorKind& value)
+    {
+        uint8_t code = 0;
+        raw(code);
+        value = static_cast<SensorKind>(code);
+    }
+
+    void get(std::string& value)
+    {
+        uint32_t size = 0;
+        raw(size);
+        if (!m_ok || static_cast<size_t>(m_end - m_pos) < size) {
+            m_ok = false;
+            value.clear();
+            return;
+        }
+        value.assign(m_pos, size);
+        m_pos += size;
+    }
+
+    template <typename T>
+    void get(std::optional<T>& value)
+    {
+        uint8_t present = 0;
+        raw(present);
+        if (!m_ok || present == 0) {
+            value.reset();
+            return;
+        }
+        if (!value.has_value()) value.emplace();
+        get(value.value());
+    }
+
+    template <typename T>
+    void get(std::vector<T>& values)
+    {
+        uint32_t count = 0;
+        raw(count);
+        // Кожен елемент займає щонайменше байт - захист від пошкодженої довжини
+        if (!m_ok || static_cast<size_t>(m_end - m_pos) < count) {
+            m_ok = false;
+            values.clear();
+            return;
+        }
+        values.resize(count);
+        for (T& value : values) get(value);
+    }
+
+    void get(PressureStats& stats)
+    {
+        get(stats.avg10);
+        get(stats.avg60);
+        get(stats.avg300);
+        get(stats.total_us);
+    }
+
+    void get(PressureInfo& info)
+    {
+        get(info.some);
+        get(info.full);
+    }
+
+    void get(SystemPressure& pressure)
+    {
+        get(pressure.cpu);
+        get(pressure.memory);
+        get(pressure.io);
+    }
+
+    void get(CgroupLimits& limits)
+    {
+        get(limits.path);
+        get(limits.cpu_quota_us);
+        get(limits.cpu_period_us);
+        get(limits.cpu_quota_cores);
+        get(limits.cpuset_cpus);
+        get(limits.memory_max_mb);
+        get(limits.memory_high_mb);
+        get(limits.memory_current_mb);
+    }
+
+    void get(SensorReading& sensor)
+    {
+        get(sensor.chip);
+        get(sensor.label);
+        get(sensor.device);
+        if (m_version >= 2)
+            get(sensor.source);
+        else
+            sensor.source.clear();
+        get(sensor.kind);
+        get(sensor.value);
+    }
+
+    void get(GPUInfo& gpu)
+    {
+        get(gpu.model);
+        get(gpu.vram_mb);
+        get(gpu.vram_used_mb);
+        get(gpu.vram_free_mb);
+        get(gpu.vram_usage_percent);
+        get(gpu.pci_address);
+        get(gpu.sensors);
+    }
+
+    void get(DiskIOStats& io)
+    {
+        get(io.device);
+        get(io.reads_completed);
+        get(io.writes_completed);
+        get(io.read_bytes);
+        get(io.write_bytes);
+        get(io.in_flight);
+        get(io.read_mb_per_sec);
+        get(io.write_mb_per_sec);
+        get(io.read_iops);
+        get(io.write_iops);
+        get(io.await_ms);
+        get(io.avg_queue_depth);
+        get(io.util_percent);
+    }
+
+    void get(DiskInfo& disk)
+    {
+        get(disk.mount_point);
+        get(disk.filesystem);
+        get(disk.type);
+        get(disk.total_mb);
+        get(disk.free_mb);
+        get(disk.used_mb);
+        get(disk.usage_percent);
+        get(disk.free_percent);
+        get(disk.block_device);
+        get(disk.io);
+    }
+
+    void get(NetInterfaceInfo& nic)
+    {
+        get(nic.name);
+        get(nic.speed_mbps);
+        get(nic.mtu);
+        get(nic.rx_bytes);
+        get(nic.rx_packets);
+        get(nic.rx_errors);
+        get(nic.rx_drops);
+        get(nic.tx_bytes);
+        get(nic.tx_packets);
+        get(nic.tx_errors);
+        get(nic.tx_drops);
+        get(nic.rx_mb_per_sec);
+        get(nic.tx_mb_per_sec);
+        get(nic.rx_packets_per_sec);
+        get(nic.tx_packets_per_sec);
+        get(nic.rx_errors_per_sec);
+        get(nic.tx_errors_per_sec);
+        get(nic.rx_drops_per_sec);
+        get(nic.tx_drops_per_sec);
+        get(nic.link_usage_percent);
+    }
+
+    void get(PowerDomainInfo& domain)
+    {
+        get(domain.zone);
+        get(domain.name);
+        get(domain.energy_uj);
+        get(domain.power_w);
+    }
+
+private:
+    const char* m_pos;
+    const char* m_end;
+    bool m_ok = true;
+    uint8_t m_version = SnapshotCodec::kVersion;   // Поля, яких у старій версії ще не було
+};
+
+} // namespace
+
+// ========================================
+// ArgentumDevice
+// ========================================
+
+void SnapshotCodec::encode(const ArgentumDevice& device, std::string& out)
+{
+    Writer writer(out);
+    writer.put(kVersion);
+
+    writer.put(device.os);
+    writer.put(device.os_kernel);
+    writer.put(device.os_arch);
+    writer.put(device.platform);
+
+    writer.put(device.cpu_model);
+    writer.put(device.cpu_cores);
+    writer.put(device.cpu_frequency_mhz);
+
+    writer.put(device.ram_mb);
+    writer.put(device.ram_used_mb);
+    writer.put(device.ram_available_mb);
+    writer.put(device.ram_usage_percent);
+
+    writer.put(device.effective_cpu_cores);
+    writer.put(device.effective_ram_mb);
+    writer.put(device.cgroup);
+
+    writer.put(device.pressure);
+    writer.put(device.cgroup_pressure);
+
+    writer.put(device.gpu_count);
+    writer.put(device.gpus);
+
+    writer.put(device.primary_disk_type);
+    writer.put(device.disks);
+    writer.put(device.total_disk_mb);
+    writer.put(device.free_disk_mb);
+    writer.put(device.used_disk_mb);
+    writer.put(device.disk_usage_percent);
+    writer.put(device.disk_io);
+
+    writer.put(device.network);
+    writer.put(device.sensors);
+    writer.put(device.power_domains);
+    writer.put(device.package_power_w);
+}
+
+bool SnapshotCodec::decode(const char* data, size_t size, ArgentumDevice& device)
+{
+    Reader reader(data, size);
+    uint8_t version = 0;
+    reader.get(version);
+    if (!reader.ok() || version == 0 || version > kVersion)
+        return false;
+    reader.setVersion(version);
+
+    reader.get(device.os);
+    reader.get(device.os_kernel);
+    reader.get(device.os_arch);
+    reader.get(device.platform);
+
+    reader.get(device.cpu_model);
+    reader.get(device.cpu_cores);
+    reader.get(device.cpu_frequency_mhz);
+
+    reader.get(device.ram_mb);
+    reader.get(device.ram_used_mb);
+    reader.get(device.ram_available_mb);
+    reader.get(device.ram_usage_percent);
+
+    reader.get(device.effective_cpu_cores);
+    reader.get(device.effective_ram_mb);
+    reader.get(device.cgroup);
+
+    reader.get(device.pressure);
+    reader.get(device.cgroup_pressure);
+
+    reader.get(device.gpu_count);
+    reader.get(device.gpus);
+
+    reader.get(device.primary_disk_type);
+    reader.get(device.disks);
+    reader.get(device.total_disk_mb);
+    reader.get(device.free_disk_mb);
+    reader.get(device.used_disk_mb);
+    reader.get(device.disk_usage_percent);
+    reader.get(device.disk_io);
+
+    reader.get(device.network);
+    reader.get(device.sensors);
+    reader.get(device.power_domains);
+    reader.get(device.package_power_w);
+
+    return reader.ok() && reader.atEnd();
+}
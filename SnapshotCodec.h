@@ -0,0 +1,30 @@
+#ifndef SNAPSHOTCODEC_H
+#define SNAPSHOTCODEC_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include "DeviceInfo.h"
+
+// ========================================
+// Клас SnapshotCodec - двійкове кодування ArgentumDevice
+// ========================================
+//
+// Компактний формат для SnapshotLog: поля у порядку оголошення, числа
+// фіксованої ширини в порядку байтів хоста, рядки та вектори з довжиною
+// u32, std::optional - байт-прапорець перед значенням. Перший байт -
+// версія формату; decode() відкидає невідому версію та обрізані дані.
+// Версія 2 додала SensorReading::source; записи версії 1 читаються без нього.
+class SnapshotCodec
+{
+public:
+    static constexpr uint8_t kVersion = 2;
+
+    // Дописує у кінець out (ємність out перевикористовується)
+    static void encode(const ArgentumDevice& device, std::string& out);
+
+    // false - дані пошкоджені або іншої версії; device тоді не визначений
+    static bool decode(const char* data, size_t size, ArgentumDevice& device);
+};
+
+#endif // SNAPSHOTCODEC_H
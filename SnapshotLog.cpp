@@ -0,0 +1,594 @@
+#include "SnapshotLog.h"
+#include "SnapshotCodec.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#ifdef __linux__
+#include <cerrno>
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+// ========================================
+// Формат сегмента
+// ========================================
+
+const char kSegmentMagic[8] = { 'H', 'W', 'S', 'N', 'P', 'L', 'O', 'G' };
+const uint32_t kSegmentVersion = 1;
+const size_t kSegmentHeaderSize = 64;
+const size_t kRecordHeaderSize = 16;
+const uint64_t kMinSegmentBytes = 4096;
+
+struct SegmentHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t header_size;
+    uint64_t segment_bytes;
+    uint64_t sequence;
+    uint64_t high_water;    // Кінець найдальшого розпочатого запису - межа сміття після збою
+};
+static_assert(sizeof(SegmentHeader) <= kSegmentHeaderSize, "заголовок сегмента не вміщується");
+
+struct RecordHeader {
+    uint32_t length;        // 0 - записів далі немає
+    uint32_t crc;           // CRC32 мітки часу та даних
+    int64_t timestamp_ms;
+};
+static_assert(sizeof(RecordHeader) == kRecordHeaderSize, "неочікуваний розмір заголовка запису");
+
+const size_t kHighWaterOffset = offsetof(SegmentHeader, high_water);
+
+uint64_t alignedRecordSize(uint64_t payload)
+{
+    return (kRecordHeaderSize + payload + 7) & ~uint64_t(7);
+}
+
+// CRC-32 (IEEE 802.3)
+uint32_t crc32(uint32_t crc, const void* data, size_t size)
+{
+    static const std::array<uint32_t, 256> table = [] {
+        std::array<uint32_t, 256> result{};
+        for (uint32_t i = 0; i < 256; ++i) {
+            uint32_t c = i;
+            for (int bit = 0; bit < 8; ++bit)
+                c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            result[i] = c;
+        }
+        return result;
+    }();
+
+    const auto* bytes = static_cast<const unsigned char*>(data);
+    crc = ~crc;
+    for (size_t i = 0; i < size; ++i)
+        crc = table[(crc ^ bytes[i]) & 0xFF] ^ (crc >> 8);
+    return ~crc;
+}
+
+uint32_t recordCrc(int64_t timestampMs, const char* data, size_t size)
+{
+    return crc32(crc32(0, &timestampMs, sizeof(timestampMs)), data, size);
+}
+
+std::string segmentName(uint64_t sequence)
+{
+    char name[64];
+    snprintf(name, sizeof(name), "segment-%010llu.hwlog", static_cast<unsigned long long>(sequence));
+    return name;
+}
+
+bool parseSegmentName(const char* name, uint64_t& sequence)
+{
+    static const char prefix[] = "segment-";
+    static const char suffix[] = ".hwlog";
+    if (strncmp(name, prefix, sizeof(prefix) - 1) != 0)
+        return false;
+
+    const char* digits = name + sizeof(prefix) - 1;
+    char* end = nullptr;
+    unsigned long long value = strtoull(digits, &end, 10);
+    if (end == digits || strcmp(end, suffix) != 0)
+        return false;
+
+    sequence = value;
+    return true;
+}
+
+} // namespace
+
+// ========================================
+// Конструктор та деструктор
+// ========================================
+
+SnapshotLog::SnapshotLog(const std::string &directory, const SnapshotLogOptions &options)
+    : m_directory(directory),
+      m_options(options)
+{
+    // Розмір кратний 8, щоб вирівняні записи не виходили за кінець файлу
+    m_options.segment_bytes = (std::max(m_options.segment_bytes, kMinSegmentBytes) + 7) & ~uint64_t(7);
+    if (m_options.index_interval == 0)
+        m_options.index_interval = 1;
+}
+
+SnapshotLog::~SnapshotLog()
+{
+    close();
+}
+
+// ========================================
+// Відкриття та закриття
+// ========================================
+
+bool SnapshotLog::open()
+{
+#ifdef __linux__
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_open)
+        return true;
+
+    if (mkdir(m_directory.c_str(), 0755) != 0 && errno != EEXIST)
+        return false;
+
+    DIR* dir = opendir(m_directory.c_str());
+    if (!dir)
+        return false;
+
+    std::vector<uint64_t> sequences;
+    while (const dirent* entry = readdir(dir)) {
+        uint64_t sequence = 0;
+        if (parseSegmentName(entry->d_name, sequence))
+            sequences.push_back(sequence);
+    }
+    closedir(dir);
+    std::sort(sequences.begin(), sequences.end());
+
+    m_recoveredBytes = 0;
+    m_unreadableSegments.clear();
+    m_lastSequence = sequences.empty() ? 0 : sequences.back();
+    for (size_t i = 0; i < sequences.size(); ++i) {
+        const bool last = i + 1 == sequences.size();
+        const std::string path = m_directory + "/" + segmentName(sequences[i]);
+        // Запис можливий лише в останній сегмент; решта відображаються тільки на читання
+        const SegmentStatus status = openSegment(path, sequences[i], last);
+        if (status == SegmentStatus::Opened)
+            continue;
+
+        if (status == SegmentStatus::Empty && last) {
+            // Збій між створенням файлу та записом заголовка - записів там немає
+            unlink(path.c_str());
+            continue;
+        }
+        if (last) {
+            // Активний сегмент з записами, який не вдалося відкрити (ENOMEM, EMFILE,
+            // EACCES, інша версія) - не видаляємо і не пишемо повз нього
+            for (auto& segment : m_segments)
+                unmapSegment(*segment);
+            m_segments.clear();
+            m_unreadableSegments.push_back(path);
+            return false;
+        }
+        m_unreadableSegments.push_back(path);
+    }
+
+    m_open = true;
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool SnapshotLog::isOpen() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_open;
+}
+
+void SnapshotLog::close()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (auto& segment : m_segments)
+        unmapSegment(*segment);
+    m_segments.clear();
+    m_open = false;
+}
+
+// ========================================
+// Сегменти
+// ========================================
+
+SnapshotLog::SegmentStatus SnapshotLog::openSegment(const std::string &path, uint64_t sequence, bool writable)
+{
+#ifdef __linux__
+    int fd = ::open(path.c_str(), (writable ? O_RDWR : O_RDONLY) | O_CLOEXEC);
+    if (fd < 0)
+        return SegmentStatus::Failed;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        ::close(fd);
+        return SegmentStatus::Failed;
+    }
+
+    if (st.st_size < static_cast<off_t>(kSegmentHeaderSize)) {
+        // Обрізаний файл порожній, лише якщо в ньому самі нулі
+        char head[kSegmentHeaderSize] = {};
+        ssize_t n = st.st_size > 0 ? pread(fd, head, static_cast<size_t>(st.st_size), 0) : 0;
+        ::close(fd);
+        if (n != static_cast<ssize_t>(st.st_size))
+            return SegmentStatus::Failed;
+        return std::all_of(head, head + n, [](char c) { return c == 0; }) ? SegmentStatus::Empty : SegmentStatus::Failed;
+    }
+
+    const size_t size = static_cast<size_t>(st.st_size);
+    void* base = mmap(nullptr, size, writable ? PROT_READ | PROT_WRITE : PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (base == MAP_FAILED)
+        return SegmentStatus::Failed;
+
+    SegmentHeader header;
+    memcpy(&header, base, sizeof(header));
+    if (memcmp(header.magic, kSegmentMagic, sizeof(kSegmentMagic)) != 0 ||
+        header.version != kSegmentVersion ||
+        header.header_size != kSegmentHeaderSize ||
+        header.segment_bytes != size ||
+        size % 8 != 0) {
+        // Нульовий заголовок - файл створено, але заголовок не записано
+        const char* bytes = static_cast<const char*>(base);
+        const bool empty = std::all_of(bytes, bytes + kSegmentHeaderSize, [](char c) { return c == 0; });
+        munmap(base, size);
+        return empty ? SegmentStatus::Empty : SegmentStatus::Failed;
+    }
+
+    auto segment = std::make_unique<Segment>();
+    segment->path = path;
+    segment->sequence = sequence;
+    segment->base = static_cast<char*>(base);
+    segment->size = size;
+    segment->writable = writable;
+    scanSegment(*segment);
+    // Активний сегмент міг змінитися відновленням хвоста - перший flush() скидає його весь
+    segment->synced = writable ? 0 : segment->tail;
+    m_segments.push_back(std::move(segment));
+    return SegmentStatus::Opened;
+#else
+    (void)path;
+    (void)sequence;
+    (void)writable;
+    return SegmentStatus::Failed;
+#endif
+}
+
+bool SnapshotLog::createSegment(uint64_t sequence)
+{
+#ifdef __linux__
+    const std::string path = m_directory + "/" + segmentName(sequence);
+    int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_EXCL | O_CLOEXEC, 0644);
+    if (fd < 0)
+        return false;
+
+    // Блоки резервуються одразу: на переповненому диску запис у mmap дав би SIGBUS
+    const size_t size = static_cast<size_t>(m_options.segment_bytes);
+    if (posix_fallocate(fd, 0, static_cast<off_t>(size)) != 0) {
+        ::close(fd);
+        unlink(path.c_str());
+        return false;
+    }
+
+    void* base = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (base == MAP_FAILED) {
+        unlink(path.c_str());
+        return false;
+    }
+
+    SegmentHeader header{};
+    memcpy(header.magic, kSegmentMagic, sizeof(kSegmentMagic));
+    header.version = kSegmentVersion;
+    header.header_size = kSegmentHeaderSize;
+    header.segment_bytes = size;
+    header.sequence = sequence;
+    header.high_water = kSegmentHeaderSize;
+    memcpy(base, &header, sizeof(header));
+
+    auto segment = std::make_unique<Segment>();
+    segment->path = path;
+    segment->sequence = sequence;
+    segment->base = static_cast<char*>(base);
+    segment->size = size;
+    segment->writable = true;
+    segment->tail = kSegmentHeaderSize;
+    m_segments.push_back(std::move(segment));
+    return true;
+#else
+    (void)sequence;
+    return false;
+#endif
+}
+
+void SnapshotLog::scanSegment(Segment &segment)
+{
+    uint64_t offset = kSegmentHeaderSize;
+    RecordHeader header{};
+
+    while (offset + kRecordHeaderSize <= segment.size) {
+        memcpy(&header, segment.base + offset, sizeof(header));
+        if (header.length == 0 ||
+            header.length > segment.size - offset - kRecordHeaderSize ||
+            (segment.records > 0 && header.timestamp_ms < segment.last_timestamp_ms) ||
+            recordCrc(header.timestamp_ms, segment.base + offset + kRecordHeaderSize, header.length) != header.crc)
+            break;
+
+        if (segment.records % m_options.index_interval == 0)
+            segment.index.push_back({ header.timestamp_ms, offset });
+        if (segment.records == 0)
+            segment.first_timestamp_ms = header.timestamp_ms;
+        segment.last_timestamp_ms = header.timestamp_ms;
+        ++segment.records;
+        offset += alignedRecordSize(header.length);
+    }
+    segment.tail = offset;
+
+    // Хвіст після останнього цілого запису має бути нульовим. Інакше це
+    // перерваний запис: обнуляємо його, щоб наступний append() не залишив
+    // за собою сміття, яке скан прийняв би за продовження журналу
+    if (!segment.writable || offset + kRecordHeaderSize > segment.size)
+        return;
+
+    // Сміття може бути лише до high_water: append() просуває його до запису.
+    // Якщо сторінка заголовка не дійшла до диска - межа за довжиною запису,
+    // а без неї - до першої нульової сторінки (файл створюється нульовим)
+    uint64_t highWater = 0;
+    memcpy(&highWater, segment.base + kHighWaterOffset, sizeof(highWater));
+    memcpy(&header, segment.base + offset, sizeof(header));
+
+    uint64_t garbageEnd = 0;
+    if (highWater > offset)
+        garbageEnd = std::min<uint64_t>(highWater, segment.size);
+    else if (header.length != 0 && header.length <= segment.size - offset - kRecordHeaderSize)
+        garbageEnd = offset + alignedRecordSize(header.length);
+    else
+        garbageEnd = segment.size;
+
+    // Пишемо лише ненульові слова: вже нульові сторінки не стають брудними
+    const uint64_t kPageBytes = 4096;
+    uint64_t zeroed = 0;
+    uint64_t zeroRun = 0;
+    for (uint64_t pos = offset; pos < garbageEnd; pos += sizeof(uint64_t)) {
+        uint64_t word;
+        memcpy(&word, segment.base + pos, sizeof(word));
+        if (word != 0) {
+            memset(segment.base + pos, 0, sizeof(word));
+            zeroed += sizeof(word);
+            zeroRun = 0;
+        } else if ((zeroRun += sizeof(word)) >= kPageBytes && highWater <= offset) {
+            break;
+        }
+    }
+    m_recoveredBytes += zeroed;
+}
+
+void SnapshotLog::unmapSegment(Segment &segment)
+{
+#ifdef __linux__
+    if (segment.base)
+        munmap(segment.base, segment.size);
+#endif
+    segment.base = nullptr;
+}
+
+bool SnapshotLog::needsRotation(int64_t timestampMs, size_t recordBytes) const
+{
+    if (m_segments.empty() || !m_segments.back()->writable)
+        return true;
+
+    const Segment& active = *m_segments.back();
+    if (active.tail + recordBytes > active.size)
+        return true;
+
+    // Вік сегмента - за мітками записів, а не за годинником: відтворення
+    // історії дає ті ж межі сегментів
+    const int64_t maxAge = m_options.max_segment_age.count();
+    return maxAge > 0 && active.records > 0 && timestampMs - active.first_timestamp_ms >= maxAge;
+}
+
+const SnapshotLog::Segment* SnapshotLog::lastNonEmptySegment() const
+{
+    for (auto it = m_segments.rbegin(); it != m_segments.rend(); ++it) {
+        if ((*it)->records > 0)
+            return it->get();
+    }
+    return nullptr;
+}
+
+// ========================================
+// Запис
+// ========================================
+
+bool SnapshotLog::append(int64_t timestampMs, const ArgentumDevice &device)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_encodeBuffer.clear();
+    SnapshotCodec::encode(device, m_encodeBuffer);
+    return appendLocked(timestampMs, m_encodeBuffer.data(), m_encodeBuffer.size());
+}
+
+bool SnapshotLog::appendRaw(int64_t timestampMs, const char *data, size_t size)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return appendLocked(timestampMs, data, size);
+}
+
+bool SnapshotLog::appendLocked(int64_t timestampMs, const char *data, size_t size)
+{
+    if (!m_open || size == 0 || size > UINT32_MAX)
+        return false;
+
+    const uint64_t recordBytes = alignedRecordSize(size);
+    if (recordBytes > m_options.segment_bytes - kSegmentHeaderSize)
+        return false;
+
+    const Segment* last = lastNonEmptySegment();
+    if (last && timestampMs < last->last_timestamp_ms)
+        return false;
+
+    if (needsRotation(timestampMs, recordBytes)) {
+        if (!m_segments.empty())
+            m_segments.back()->writable = false;
+
+        // Номери нечитабельних сегментів не перевикористовуються
+        const uint64_t sequence = std::max(m_segments.empty() ? 0 : m_segments.back()->sequence, m_lastSequence) + 1;
+        if (!createSegment(sequence))
+            return false;
+
+        while (m_options.max_segments > 0 && m_segments.size() > m_options.max_segments) {
+            Segment& oldest = *m_segments.front();
+            unmapSegment(oldest);
+#ifdef __linux__
+            unlink(oldest.path.c_str());
+#endif
+            m_segments.erase(m_segments.begin());
+        }
+    }
+
+    Segment& active = *m_segments.back();
+    char* record = active.base + active.tail;
+
+    // Межа для відновлення після збою - до першого байта запису
+    const uint64_t highWater = active.tail + recordBytes;
+    memcpy(active.base + kHighWaterOffset, &highWater, sizeof(highWater));
+    // Читачі в процесі беруть m_mutex; порядок потрібен лише для сторінок,
+    // які переживуть падіння процесу, тож досить бар'єра компілятора
+    std::atomic_signal_fence(std::memory_order_release);
+
+    RecordHeader header;
+    header.length = 0;
+    header.crc = recordCrc(timestampMs, data, size);
+    header.timestamp_ms = timestampMs;
+    memcpy(record + kRecordHeaderSize, data, size);
+    memcpy(record, &header, sizeof(header));
+
+    // Довжина - останньою: до неї запису для скану не існує
+    std::atomic_signal_fence(std::memory_order_release);
+    const uint32_t length = static_cast<uint32_t>(size);
+    memcpy(record, &length, sizeof(length));
+
+    if (active.records % m_options.index_interval == 0)
+        active.index.push_back({ timestampMs, active.tail });
+    if (active.records == 0)
+        active.first_timestamp_ms = timestampMs;
+    active.last_timestamp_ms = timestampMs;
+    ++active.records;
+    active.tail += recordBytes;
+    return true;
+}
+
+bool SnapshotLog::flush()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_open)
+        return false;
+
+#ifdef __linux__
+    // Активний сегмент і ті, що запечатала ротація після попереднього flush();
+    // решта вже на диску. Сторінка заголовка - окремо: append() просуває в ній high_water
+    const uint64_t pageBytes = static_cast<uint64_t>(sysconf(_SC_PAGESIZE));
+    for (auto& segment : m_segments) {
+        if (segment->synced >= segment->tail)
+            continue;
+        const uint64_t from = segment->synced / pageBytes * pageBytes;
+        if (from > 0 && msync(segment->base, kSegmentHeaderSize, MS_SYNC) != 0)
+            return false;
+        if (msync(segment->base + from, segment->tail - from, MS_SYNC) != 0)
+            return false;
+        segment->synced = segment->tail;
+    }
+    return true;
+#else
+    return false;
+#endif
+}
+
+// ========================================
+// Читання
+// ========================================
+
+size_t SnapshotLog::read(int64_t fromMs, int64_t toMs, const Visitor &visit) const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    size_t visited = 0;
+
+    for (const auto& segmentPtr : m_segments) {
+        const Segment& segment = *segmentPtr;
+        if (segment.records == 0 || segment.last_timestamp_ms < fromMs)
+            continue;
+        if (segment.first_timestamp_ms > toMs)
+            break;
+
+        // Остання точка індексу з міткою < fromMs - далі лінійний скан
+        auto it = std::lower_bound(segment.index.begin(), segment.index.end(), fromMs,
+                                   [](const IndexEntry& entry, int64_t ts) { return entry.timestamp_ms < ts; });
+        uint64_t offset = it == segment.index.begin() ? kSegmentHeaderSize : std::prev(it)->offset;
+
+        RecordHeader header;
+        while (offset < segment.tail) {
+            memcpy(&header, segment.base + offset, sizeof(header));
+            if (header.timestamp_ms > toMs)
+                return visited;
+
+            if (header.timestamp_ms >= fromMs) {
+                SnapshotRecord record;
+                record.timestamp_ms = header.timestamp_ms;
+                record.data = segment.base + offset + kRecordHeaderSize;
+                record.size = header.length;
+                ++visited;
+                if (!visit(record))
+                    return visited;
+            }
+            offset += alignedRecordSize(header.length);
+        }
+    }
+    return visited;
+}
+
+bool SnapshotLog::decode(const SnapshotRecord &record, ArgentumDevice &device)
+{
+    return SnapshotCodec::decode(record.data, record.size, device);
+}
+
+std::vector<std::string> SnapshotLog::unreadableSegments() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_unreadableSegments;
+}
+
+SnapshotLog::Stats SnapshotLog::stats() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    Stats result;
+    result.segments = m_segments.size();
+    result.unreadable_segments = m_unreadableSegments.size();
+    result.recovered_bytes = m_recoveredBytes;
+
+    bool first = true;
+    for (const auto& segment : m_segments) {
+        result.records += segment->records;
+        result.bytes += segment->tail - kSegmentHeaderSize;
+        if (segment->records == 0)
+            continue;
+        if (first) {
+            result.first_timestamp_ms = segment->first_timestamp_ms;
+            first = false;
+        }
+        result.last_timestamp_ms = segment->last_timestamp_ms;
+    }
+    return result;
+}
@@ -0,0 +1,144 @@
+#ifndef SNAPSHOTLOG_H
+#define SNAPSHOTLOG_H
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "DeviceInfo.h"
+
+// ========================================
+// Параметри SnapshotLog
+// ========================================
+struct SnapshotLogOptions {
+    uint64_t segment_bytes = 64ull * 1024 * 1024;    // Розмір файлу сегмента (резервується одразу)
+    std::chrono::milliseconds max_segment_age = std::chrono::hours(1);   // 0 - ротація лише за розміром
+    uint32_t index_interval = 64;                    // Запис sparse-індексу на кожні N записів
+    size_t max_segments = 0;                         // 0 - без обмеження; інакше найстаріші видаляються
+};
+
+// ========================================
+// Один запис журналу (вказує в mmap сегмента)
+// ========================================
+struct SnapshotRecord {
+    int64_t timestamp_ms = 0;     // Мітка часу з append()
+    const char* data = nullptr;   // Закодований SnapshotCodec знімок
+    size_t size = 0;
+};
+
+// ========================================
+// Клас SnapshotLog - append-only журнал знімків у mmap-сегментах
+// ========================================
+//
+// Каталог з файлами segment-<номер>.hwlog фіксованого розміру. Запис:
+// [u32 довжина][u32 CRC32][i64 мітка часу][дані], вирівняний на 8 байт;
+// довжина пишеться останньою, тож запис, перерваний збоєм, має нульову
+// довжину або невірний CRC. Перед записом у заголовку сегмента просувається
+// high_water. open() сканує сегменти, обнуляє ненульові байти хвоста до
+// high_water і продовжує писати після останнього цілого запису.
+//
+// Мітки часу не спадають. Для кожного сегмента в пам'яті тримається
+// sparse-індекс (мітка часу -> зміщення кожного index_interval-го запису),
+// тож read() пропускає сегменти поза діапазоном і починає скан з
+// найближчої точки індексу. read() віддає вказівники прямо в mmap без
+// копіювання - вони дійсні лише всередині visit.
+//
+// Новий сегмент починається, коли запис не вміщується або перший запис
+// поточного старший за max_segment_age. Потокобезпечний (один м'ютекс).
+class SnapshotLog
+{
+public:
+    // false з visit - зупинити читання
+    using Visitor = std::function<bool(const SnapshotRecord& record)>;
+
+    struct Stats {
+        size_t segments = 0;
+        uint64_t records = 0;
+        uint64_t bytes = 0;                 // Зайнято записами в усіх сегментах
+        uint64_t recovered_bytes = 0;       // Обнулено при open() у пошкодженому хвості
+        size_t unreadable_segments = 0;     // Старші сегменти, які open() не зміг відкрити
+        int64_t first_timestamp_ms = 0;
+        int64_t last_timestamp_ms = 0;
+    };
+
+    explicit SnapshotLog(const std::string &directory, const SnapshotLogOptions &options = SnapshotLogOptions());
+    ~SnapshotLog();
+
+    SnapshotLog(const SnapshotLog&) = delete;
+    SnapshotLog& operator=(const SnapshotLog&) = delete;
+
+    // Створює каталог, відновлює хвіст останнього сегмента. false - каталог
+    // недоступний або останній сегмент з записами не відкривається (файл не
+    // чіпається); старші сегменти, що не відкрились, - в unreadableSegments()
+    bool open();
+    bool isOpen() const;
+    void close();
+
+    // false - журнал закрито, мітка часу менша за останню, запис більший
+    // за сегмент або не вдалося створити новий сегмент
+    bool append(int64_t timestampMs, const ArgentumDevice &device);
+    bool appendRaw(int64_t timestampMs, const char *data, size_t size);
+
+    bool flush();                           // msync(MS_SYNC) записаного після попереднього flush()
+
+    // Записи з мітками в [fromMs, toMs] у порядку запису; кількість переданих visit.
+    // visit виконується під м'ютексом журналу і не повинен викликати його методи
+    size_t read(int64_t fromMs, int64_t toMs, const Visitor &visit) const;
+
+    // Розкодований знімок; false - пошкоджений або іншої версії SnapshotCodec
+    static bool decode(const SnapshotRecord &record, ArgentumDevice &device);
+
+    Stats stats() const;
+    std::vector<std::string> unreadableSegments() const;
+
+private:
+    enum class SegmentStatus {
+        Opened,
+        Empty,              // Нульової довжини або з нульовим заголовком - записів немає
+        Failed
+    };
+
+    struct IndexEntry {
+        int64_t timestamp_ms;
+        uint64_t offset;
+    };
+
+    struct Segment {
+        std::string path;
+        uint64_t sequence = 0;
+        char* base = nullptr;               // mmap усього файлу (дескриптор закривається одразу)
+        size_t size = 0;
+        bool writable = false;
+        uint64_t tail = 0;                  // Кінець останнього цілого запису
+        uint64_t synced = 0;                // До цього зміщення flush() уже скинув на диск
+        uint64_t records = 0;
+        int64_t first_timestamp_ms = 0;
+        int64_t last_timestamp_ms = 0;
+        std::vector<IndexEntry> index;
+    };
+
+    bool appendLocked(int64_t timestampMs, const char *data, size_t size);
+    SegmentStatus openSegment(const std::string &path, uint64_t sequence, bool writable);
+    bool createSegment(uint64_t sequence);
+    void scanSegment(Segment &segment);
+    void unmapSegment(Segment &segment);
+    bool needsRotation(int64_t timestampMs, size_t recordBytes) const;
+    const Segment* lastNonEmptySegment() const;
+
+    std::string m_directory;
+    SnapshotLogOptions m_options;
+
+    mutable std::mutex m_mutex;             // Захищає все нижче
+    std::vector<std::unique_ptr<Segment>> m_segments;   // За зростанням номера; останній - активний
+    bool m_open = false;
+    uint64_t m_recoveredBytes = 0;
+    std::vector<std::string> m_unreadableSegments;
+    uint64_t m_lastSequence = 0;                // Найбільший номер у каталозі при open()
+    std::string m_encodeBuffer;             // Перевикористовується між append()
+};
+
+#endif // SNAPSHOTLOG_H
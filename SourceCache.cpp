@@ -0,0 +1,178 @@
+#include "SourceCache.h"
+
+SourceCache::Shard& SourceCache::shardFor(const std::string& key)
+{
+    return m_shards[std::hash<std::string>()(key) % kShards];
+}
+
+// ========================================
+// Читання з кешу
+// ========================================
+
+SourceCache::Lookup SourceCache::get(const std::string& key, std::chrono::milliseconds ttl,
+                                     const Fetch& fetch, std::string& value, const CancelCheck& isCanceled)
+{
+    Shard& shard = shardFor(key);
+
+    // Швидкий шлях: свіжий запис під shared-блокуванням
+    {
+        std::shared_lock<std::shared_mutex> lock(shard.mutex);
+        auto entry = shard.entries.find(key);
+        if (entry != shard.entries.end() && std::chrono::steady_clock::now() < entry->second.expires) {
+            m_hits.fetch_add(1, std::memory_order_relaxed);
+            value = entry->second.value;
+            return Lookup::Hit;
+        }
+    }
+
+    std::unique_lock<std::shared_mutex> lock(shard.mutex);
+    for (;;) {
+        // Поки чекали на ексклюзивне блокування, запис міг оновити інший потік
+        auto entry = shard.entries.find(key);
+        if (entry != shard.entries.end() && std::chrono::steady_clock::now() < entry->second.expires) {
+            m_hits.fetch_add(1, std::memory_order_relaxed);
+            value = entry->second.value;
+            return Lookup::Hit;
+        }
+
+        // Той самий ключ уже запитує інший потік - чекаємо на його результат
+        auto inflight = shard.pending.find(key);
+        if (inflight == shard.pending.end())
+            break;
+
+        std::shared_ptr<Pending> pending = inflight->second;
+        ++pending->waiters;
+        shard.fetched.wait(lock, [&pending] { return pending->done; });
+        if (pending->canceled)
+            continue;           // Скасували чужий збір, не наш - запитуємо знову
+        if (!pending->ok)
+            return Lookup::Failed;
+        m_coalesced.fetch_add(1, std::memory_order_relaxed);
+        value = pending->value;
+        return Lookup::Coalesced;
+    }
+
+    auto pending = std::make_shared<Pending>();
+    shard.pending[key] = pending;
+    m_misses.fetch_add(1, std::memory_order_relaxed);
+    lock.unlock();
+
+    // Вивід fetch читається в буфер потоку: його ємність переживає запити, і
+    // повторні fetch не перевиділяють пам'ять під вивід. fetch не має викликати
+    // get() на тому ж потоці - вкладений запит перезаписав би буфер
+    thread_local std::string t_fetched;
+    std::string& fetched = t_fetched;
+    fetched.clear();
+    try {
+        pending->ok = fetch(fetched);
+        pending->canceled = !pending->ok && isCanceled && isCanceled();
+    }
+    catch (...) {
+        // Без цього pending лишився б у шарді, і очікувачі висіли б вічно
+        pending->ok = false;
+        pending->canceled = false;
+        finishFetch(shard, key, *pending, ttl, fetched);
+        throw;
+    }
+
+    finishFetch(shard, key, *pending, ttl, fetched);
+
+    if (!pending->ok)
+        return Lookup::Failed;
+    value.assign(fetched);
+    return Lookup::Fetched;
+}
+
+// Публікує результат fetch очікувачам і знімає pending з шарду. Запис, що
+// прострочився, перезаписується на місці - без нового рядка під значення,
+// а копія для очікувачів робиться, лише якщо вони є
+void SourceCache::finishFetch(Shard& shard, const std::string& key, Pending& pending,
+                              std::chrono::milliseconds ttl, const std::string& fetched)
+{
+    std::unique_lock<std::shared_mutex> lock(shard.mutex);
+    pending.done = true;
+    if (pending.ok) {
+        if (pending.waiters > 0)
+            pending.value.assign(fetched);
+        if (!pending.invalidated) {
+            Entry& entry = shard.entries[key];
+            entry.value.assign(fetched);
+            entry.expires = std::chrono::steady_clock::now() + ttl;
+        }
+    }
+    else {
+        m_failures.fetch_add(1, std::memory_order_relaxed);
+    }
+    shard.pending.erase(key);
+    shard.fetched.notify_all();
+}
+
+bool SourceCache::lookup(const std::string& key, std::string& value)
+{
+    Shard& shard = shardFor(key);
+    std::shared_lock<std::shared_mutex> lock(shard.mutex);
+    auto entry = shard.entries.find(key);
+    if (entry == shard.entries.end() || std::chrono::steady_clock::now() >= entry->second.expires) {
+        m_misses.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    m_hits.fetch_add(1, std::memory_order_relaxed);
+    value = entry->second.value;
+    return true;
+}
+
+void SourceCache::store(const std::string& key, const std::string& value, std::chrono::milliseconds ttl)
+{
+    Shard& shard = shardFor(key);
+    std::unique_lock<std::shared_mutex> lock(shard.mutex);
+    shard.entries[key] = Entry{ value, std::chrono::steady_clock::now() + ttl };
+}
+
+// ========================================
+// Інвалідація
+// ========================================
+
+void SourceCache::invalidate(const std::string& key)
+{
+    Shard& shard = shardFor(key);
+    std::unique_lock<std::shared_mutex> lock(shard.mutex);
+    m_invalidations.fetch_add(shard.entries.erase(key), std::memory_order_relaxed);
+
+    auto inflight = shard.pending.find(key);
+    if (inflight != shard.pending.end())
+        inflight->second->invalidated = true;
+}
+
+void SourceCache::invalidatePrefix(const std::string& prefix)
+{
+    for (Shard& shard : m_shards) {
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+        for (auto entry = shard.entries.lower_bound(prefix); entry != shard.entries.end();) {
+            if (entry->first.compare(0, prefix.size(), prefix) != 0)
+                break;
+            entry = shard.entries.erase(entry);
+            m_invalidations.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        for (auto inflight = shard.pending.lower_bound(prefix); inflight != shard.pending.end(); ++inflight) {
+            if (inflight->first.compare(0, prefix.size(), prefix) != 0)
+                break;
+            inflight->second->invalidated = true;
+        }
+    }
+}
+
+SourceCache::Stats SourceCache::stats() const
+{
+    Stats result;
+    result.hits = m_hits.load(std::memory_order_relaxed);
+    result.misses = m_misses.load(std::memory_order_relaxed);
+    result.coalesced = m_coalesced.load(std::memory_order_relaxed);
+    result.failures = m_failures.load(std::memory_order_relaxed);
+    result.invalidations = m_invalidations.load(std::memory_order_relaxed);
+    for (const Shard& shard : m_shards) {
+        std::shared_lock<std::shared_mutex> lock(shard.mutex);
+        result.entries += shard.entries.size();
+    }
+    return result;
+}
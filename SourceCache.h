@@ -0,0 +1,107 @@
+#ifndef SOURCECACHE_H
+#define SOURCECACHE_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+
+// ========================================
+// Клас SourceCache - TTL-кеш результатів повільних джерел
+// ========================================
+//
+// Ключ - джерело ("cmd:lspci -v", "wmi:disk:C"), значення - його сирий
+// вивід. Кожен запис має власний TTL. Паралельні get() з одним ключем
+// чекають на один fetch замість запуску власного. Невдалий fetch не
+// кешується. invalidate() під час fetch не дає записати застарілий результат.
+// fetch, скасований своїм викликачем (isCanceled), або виняток з fetch не
+// стають результатом для очікувачів: скасування - вони запускають fetch самі,
+// виняток - отримують Failed, а сам виняток летить далі з get() власника.
+//
+// Потокобезпечний. Ключі розкладено по kShards шардах за хешем; влучання
+// в кеш бере лише shared-блокування свого шарду, тож паралельні читачі
+// не серіалізуються, а fetch одного ключа не блокує інші шарди.
+class SourceCache
+{
+public:
+    using Fetch = std::function<bool(std::string& value)>;
+    using CancelCheck = std::function<bool()>;
+
+    enum class Lookup : uint8_t {
+        Hit = 0,           // Свіжий запис з кешу
+        Fetched = 1,       // Виконано fetch, результат збережено
+        Coalesced = 2,     // Дочекалися fetch іншого потоку
+        Failed = 3         // fetch повернув false
+    };
+
+    struct Stats {
+        uint64_t hits = 0;
+        uint64_t misses = 0;           // Виконані fetch
+        uint64_t coalesced = 0;
+        uint64_t failures = 0;
+        uint64_t invalidations = 0;    // Видалені записи
+        size_t entries = 0;
+    };
+
+    SourceCache() = default;
+    SourceCache(const SourceCache&) = delete;
+    SourceCache& operator=(const SourceCache&) = delete;
+
+    // isCanceled перевіряється після невдалого fetch: скасування цього виклику
+    // не передається потокам, що чекали на той самий ключ
+    Lookup get(const std::string& key, std::chrono::milliseconds ttl, const Fetch& fetch, std::string& value,
+               const CancelCheck& isCanceled = CancelCheck());
+
+    // Без fetch: для джерел, які не зводяться до одного виклику (WMI-цикл)
+    bool lookup(const std::string& key, std::string& value);
+    void store(const std::string& key, const std::string& value, std::chrono::milliseconds ttl);
+
+    void invalidate(const std::string& key);
+    void invalidatePrefix(const std::string& prefix);     // "" - весь кеш
+
+    Stats stats() const;
+
+private:
+    static constexpr size_t kShards = 16;
+
+    struct Entry {
+        std::string value;
+        std::chrono::steady_clock::time_point expires;
+    };
+
+    struct Pending {
+        bool done = false;
+        bool ok = false;
+        bool canceled = false;         // Очікувачі повторюють fetch самі
+        bool invalidated = false;
+        size_t waiters = 0;            // Потоки, яким потрібна копія value
+        std::string value;
+    };
+
+    struct Shard {
+        mutable std::shared_mutex mutex;
+        std::condition_variable_any fetched;
+        std::map<std::string, Entry> entries;
+        std::map<std::string, std::shared_ptr<Pending>> pending;
+    };
+
+    Shard& shardFor(const std::string& key);
+    void finishFetch(Shard& shard, const std::string& key, Pending& pending, std::chrono::milliseconds ttl,
+                     const std::string& fetched);
+
+    Shard m_shards[kShards];
+    std::atomic<uint64_t> m_hits{ 0 };
+    std::atomic<uint64_t> m_misses{ 0 };
+    std::atomic<uint64_t> m_coalesced{ 0 };
+    std::atomic<uint64_t> m_failures{ 0 };
+    std::atomic<uint64_t> m_invalidations{ 0 };
+};
+
+#endif // SOURCECACHE_H
@@ -0,0 +1,275 @@
+#include "Tracer.h"
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#ifdef _WIN32
+#include <process.h>
+#else
+#include <unistd.h>
+#endif
+
+std::atomic<bool> Tracer::s_enabled{ false };
+
+namespace {
+
+// ========================================
+// Буфер потоку: однозв'язний список блоків
+// ========================================
+//
+// Пише лише потік-власник; count та next публікуються з release, тому
+// читач (flush) бачить лише повністю записані події.
+struct Chunk {
+    TraceEvent events[Tracer::kChunkEvents];
+    std::atomic<size_t> count{ 0 };
+    std::atomic<Chunk*> next{ nullptr };
+};
+
+struct ThreadBuffer {
+    uint32_t tid = 0;
+    std::atomic<Chunk*> head{ nullptr };
+    Chunk* tail = nullptr;              // Лише потік-власник
+    size_t chunks = 0;                  // Лише потік-власник
+    std::atomic<uint64_t> dropped{ 0 };
+
+    void release()
+    {
+        Chunk* chunk = head.exchange(nullptr, std::memory_order_acq_rel);
+        while (chunk) {
+            Chunk* next = chunk->next.load(std::memory_order_acquire);
+            delete chunk;
+            chunk = next;
+        }
+        tail = nullptr;
+        chunks = 0;
+        dropped.store(0, std::memory_order_relaxed);
+    }
+
+    ~ThreadBuffer() { release(); }
+};
+
+// Буфери живуть довше за свої потоки, щоб flush бачив події завершених потоків
+struct Registry {
+    std::mutex mutex;
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+    uint32_t nextTid = 1;
+};
+
+Registry& registry()
+{
+    static Registry* instance = new Registry();     // Без деструктора: потоки можуть пережити main()
+    return *instance;
+}
+
+ThreadBuffer& threadBuffer()
+{
+    thread_local std::shared_ptr<ThreadBuffer> buffer;
+    if (!buffer) {
+        auto fresh = std::make_shared<ThreadBuffer>();
+        Registry& reg = registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        fresh->tid = reg.nextTid++;
+        reg.buffers.push_back(fresh);
+        buffer = fresh;
+    }
+    return *buffer;
+}
+
+std::vector<std::shared_ptr<ThreadBuffer>> snapshotBuffers()
+{
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    return reg.buffers;
+}
+
+// Копіює рядок у фіксований буфер; для шляхів зберігається кінець ("...nvme0n1/stat")
+void copyTruncated(char* destination, size_t size, const char* source, bool keepTail)
+{
+    if (!source) {
+        destination[0] = '\0';
+        return;
+    }
+    size_t length = strlen(source);
+    if (length >= size) {
+        if (keepTail) source += length - (size - 1);
+        length = size - 1;
+    }
+    memcpy(destination, source, length);
+    destination[length] = '\0';
+}
+
+void writeJsonString(std::ostream& out, const char* value)
+{
+    out << '"';
+    for (const char* c = value; *c; ++c) {
+        unsigned char ch = static_cast<unsigned char>(*c);
+        if (ch == '"' || ch == '\\') {
+            out << '\\' << *c;
+        }
+        else if (ch < 0x20) {
+            char escaped[8];
+            snprintf(escaped, sizeof(escaped), "\\u%04x", ch);
+            out << escaped;
+        }
+        else {
+            out << *c;
+        }
+    }
+    out << '"';
+}
+
+int processId()
+{
+#ifdef _WIN32
+    return _getpid();
+#else
+    return static_cast<int>(getpid());
+#endif
+}
+
+} // namespace
+
+// ========================================
+// Tracer
+// ========================================
+
+void Tracer::setEnabled(bool enabled)
+{
+    s_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+uint64_t Tracer::nowUs()
+{
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+void Tracer::record(const TraceEvent& event)
+{
+    ThreadBuffer& buffer = threadBuffer();
+
+    Chunk* chunk = buffer.tail;
+    if (!chunk || chunk->count.load(std::memory_order_relaxed) == kChunkEvents) {
+        if (buffer.chunks == kMaxChunksPerThread) {
+            buffer.dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        Chunk* fresh = new Chunk;
+        if (chunk) chunk->next.store(fresh, std::memory_order_release);
+        else buffer.head.store(fresh, std::memory_order_release);
+        buffer.tail = fresh;
+        ++buffer.chunks;
+        chunk = fresh;
+    }
+
+    size_t index = chunk->count.load(std::memory_order_relaxed);
+    chunk->events[index] = event;
+    chunk->count.store(index + 1, std::memory_order_release);
+}
+
+size_t Tracer::eventCount()
+{
+    size_t total = 0;
+    for (const auto& buffer : snapshotBuffers()) {
+        for (Chunk* chunk = buffer->head.load(std::memory_order_acquire); chunk;
+             chunk = chunk->next.load(std::memory_order_acquire)) {
+            total += chunk->count.load(std::memory_order_acquire);
+        }
+    }
+    return total;
+}
+
+uint64_t Tracer::droppedCount()
+{
+    uint64_t total = 0;
+    for (const auto& buffer : snapshotBuffers()) {
+        total += buffer->dropped.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+void Tracer::clear()
+{
+    for (const auto& buffer : snapshotBuffers()) {
+        buffer->release();
+    }
+}
+
+void Tracer::writeChromeTrace(std::ostream& out)
+{
+    const int pid = processId();
+    const std::vector<std::shared_ptr<ThreadBuffer>> buffers = snapshotBuffers();
+
+    out << "{\"traceEvents\":[\n";
+    bool first = true;
+    uint64_t dropped = 0;
+    for (const auto& buffer : buffers) {
+        Chunk* head = buffer->head.load(std::memory_order_acquire);
+        if (!head)
+            continue;
+
+        // Підпис треку потоку в Perfetto
+        out << (first ? "" : ",\n")
+            << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":" << pid << ",\"tid\":" << buffer->tid
+            << ",\"args\":{\"name\":\"hwinfo-" << buffer->tid << "\"}}";
+        first = false;
+
+        for (Chunk* chunk = head; chunk; chunk = chunk->next.load(std::memory_order_acquire)) {
+            size_t count = chunk->count.load(std::memory_order_acquire);
+            for (size_t i = 0; i < count; ++i) {
+                const TraceEvent& event = chunk->events[i];
+                out << ",\n{\"name\":";
+                writeJsonString(out, event.name);
+                out << ",\"cat\":\"" << event.category << "\",\"ph\":\"X\""
+                    << ",\"ts\":" << event.start_us << ",\"dur\":" << event.duration_us
+                    << ",\"pid\":" << pid << ",\"tid\":" << buffer->tid;
+                if (event.detail[0] != '\0') {
+                    out << ",\"args\":{\"detail\":";
+                    writeJsonString(out, event.detail);
+                    out << "}";
+                }
+                out << "}";
+            }
+        }
+        dropped += buffer->dropped.load(std::memory_order_relaxed);
+    }
+    out << "\n],\"displayTimeUnit\":\"ms\",\"otherData\":{\"dropped_events\":" << dropped << "}}\n";
+}
+
+bool Tracer::writeChromeTrace(const std::string& path)
+{
+    std::ofstream out(path);
+    if (!out.is_open())
+        return false;
+    writeChromeTrace(out);
+    return out.good();
+}
+
+// ========================================
+// TraceSpan
+// ========================================
+
+void TraceSpan::begin(const char* category, const char* name, const char* detail)
+{
+    m_active = true;
+    m_event.category = category;
+    copyTruncated(m_event.name, sizeof(m_event.name), name, false);
+    copyTruncated(m_event.detail, sizeof(m_event.detail), detail, true);
+    m_event.start_us = Tracer::nowUs();
+}
+
+void TraceSpan::end()
+{
+    m_event.duration_us = Tracer::nowUs() - m_event.start_us;
+    Tracer::record(m_event);
+}
+
+void TraceSpan::setDetail(const char* detail)
+{
+    if (m_active)
+        copyTruncated(m_event.detail, sizeof(m_event.detail), detail, true);
+}
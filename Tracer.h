@@ -0,0 +1,86 @@
+#ifndef TRACER_H
+#define TRACER_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+// ========================================
+// Одна подія трасування (complete event, "ph": "X")
+// ========================================
+struct TraceEvent {
+    const char* category = "";     // "probe", "subprocess", "file" - лише рядкові літерали
+    char name[32];                 // Копія: джерело може не дожити до flush
+    char detail[64];               // Шлях файлу / програма; обрізається зліва
+    uint64_t start_us = 0;
+    uint64_t duration_us = 0;
+};
+
+// ========================================
+// Tracer - Chrome trace_event для Perfetto / about://tracing
+// ========================================
+//
+// Кожен потік пише у власний буфер (блоки по kChunkEvents подій), тому
+// запис span'а не бере м'ютексів: лише реєстрація потоку при першій події.
+// Вимкнений трасувальник коштує одного relaxed-читання atomic<bool>.
+// writeChromeTrace() можна викликати паралельно із записом - він бачить
+// лише вже опубліковані події. clear() звільняє блоки, тому його слід
+// викликати, коли збір не виконується.
+class Tracer
+{
+public:
+    static constexpr size_t kChunkEvents = 1024;
+    static constexpr size_t kMaxChunksPerThread = 256;     // Далі події відкидаються
+
+    static void setEnabled(bool enabled);
+    static bool isEnabled() { return s_enabled.load(std::memory_order_relaxed); }
+
+    static uint64_t nowUs();
+    static void record(const TraceEvent& event);
+
+    static size_t eventCount();
+    static uint64_t droppedCount();
+    static void clear();
+
+    static void writeChromeTrace(std::ostream& out);
+    static bool writeChromeTrace(const std::string& path);
+
+private:
+    static std::atomic<bool> s_enabled;
+};
+
+// ========================================
+// TraceSpan - RAII-проміжок від конструктора до деструктора
+// ========================================
+class TraceSpan
+{
+public:
+    TraceSpan(const char* category, const char* name, const char* detail = nullptr)
+    {
+        if (Tracer::isEnabled())
+            begin(category, name, detail);
+    }
+
+    ~TraceSpan()
+    {
+        if (m_active)
+            end();
+    }
+
+    TraceSpan(const TraceSpan&) = delete;
+    TraceSpan& operator=(const TraceSpan&) = delete;
+
+    bool isActive() const { return m_active; }
+    void setDetail(const char* detail);     // Лише для активного span'а
+
+private:
+    void begin(const char* category, const char* name, const char* detail);
+    void end();
+
+    bool m_active = false;
+    TraceEvent m_event;
+};
+
+#endif // TRACER_H
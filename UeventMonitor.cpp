@@ -0,0 +1,185 @@
+#include "UeventMonitor.h"
+#include <cstring>
+
+#ifdef __linux__
+#include <cerrno>
+#include <linux/netlink.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+// Ядро обмежує uevent 2048 байтами env + заголовок
+const size_t kMessageBufferSize = 8192;
+
+// Розмір буфера сокета: витримує сплеск подій при підключенні док-станції
+const int kReceiveBufferSize = 1024 * 1024;
+
+bool isTrackedSubsystem(const std::string& subsystem)
+{
+    return subsystem == "block" || subsystem == "pci" || subsystem == "drm" || subsystem == "hwmon";
+}
+
+} // namespace
+
+// ========================================
+// Конструктор та деструктор
+// ========================================
+
+UeventMonitor::UeventMonitor(Handler handler)
+    : m_fd(-1),
+      m_handler(std::move(handler)),
+      m_buffer(kMessageBufferSize)
+{
+#ifdef __linux__
+    m_fd = socket(AF_NETLINK, SOCK_DGRAM | SOCK_CLOEXEC | SOCK_NONBLOCK, NETLINK_KOBJECT_UEVENT);
+    if (m_fd < 0)
+        return;
+
+    setsockopt(m_fd, SOL_SOCKET, SO_RCVBUF, &kReceiveBufferSize, sizeof(kReceiveBufferSize));
+
+    struct sockaddr_nl address;
+    memset(&address, 0, sizeof(address));
+    address.nl_family = AF_NETLINK;
+    address.nl_groups = 1;      // Група ядра; 2 - повторні повідомлення udev
+    if (bind(m_fd, reinterpret_cast<struct sockaddr*>(&address), sizeof(address)) != 0) {
+        close(m_fd);
+        m_fd = -1;
+    }
+#endif
+}
+
+UeventMonitor::~UeventMonitor()
+{
+#ifdef __linux__
+    if (m_fd >= 0)
+        close(m_fd);
+#endif
+}
+
+bool UeventMonitor::isValid() const
+{
+    return m_fd >= 0;
+}
+
+// ========================================
+// Розбір повідомлення
+// ========================================
+
+bool UeventMonitor::parse(const char* message, size_t length, Uevent& event)
+{
+    // Перший рядок "action@devpath"; повідомлення libudev починаються з "libudev"
+    const char* end = message + length;
+    size_t headerLength = strnlen(message, length);
+    const char* at = static_cast<const char*>(memchr(message, '@', headerLength));
+    if (at == nullptr)
+        return false;
+
+    event.action.clear();
+    event.devpath.clear();
+    event.subsystem.clear();
+    event.devname.clear();
+    event.devtype.clear();
+    event.pci_slot.clear();
+    event.pci_class.clear();
+
+    for (const char* field = message + headerLength + 1; field < end;) {
+        size_t fieldLength = strnlen(field, static_cast<size_t>(end - field));
+        const char* equals = static_cast<const char*>(memchr(field, '=', fieldLength));
+        if (equals != nullptr) {
+            size_t keyLength = static_cast<size_t>(equals - field);
+            const char* value = equals + 1;
+            size_t valueLength = fieldLength - keyLength - 1;
+
+            auto is = [&](const char* key) {
+                return strlen(key) == keyLength && memcmp(field, key, keyLength) == 0;
+            };
+            if (is("ACTION")) event.action.assign(value, valueLength);
+            else if (is("DEVPATH")) event.devpath.assign(value, valueLength);
+            else if (is("SUBSYSTEM")) event.subsystem.assign(value, valueLength);
+            else if (is("DEVNAME")) event.devname.assign(value, valueLength);
+            else if (is("DEVTYPE")) event.devtype.assign(value, valueLength);
+            else if (is("PCI_SLOT_NAME")) event.pci_slot.assign(value, valueLength);
+            else if (is("PCI_CLASS")) event.pci_class.assign(value, valueLength);
+        }
+        field += fieldLength + 1;
+    }
+
+    // Старі ядра не дублюють action/devpath у env
+    if (event.action.empty())
+        event.action.assign(message, static_cast<size_t>(at - message));
+    if (event.devpath.empty())
+        event.devpath.assign(at + 1, headerLength - static_cast<size_t>(at - message) - 1);
+
+    return !event.action.empty() && !event.subsystem.empty();
+}
+
+bool UeventMonitor::dispatch(const char* message, size_t length)
+{
+    if (!parse(message, length, m_event) || !isTrackedSubsystem(m_event.subsystem))
+        return false;
+    if (m_handler)
+        m_handler(m_event);
+    return true;
+}
+
+// ========================================
+// Отримання подій
+// ========================================
+
+size_t UeventMonitor::poll(std::chrono::milliseconds timeout)
+{
+    size_t dispatched = 0;
+#ifdef __linux__
+    if (m_fd < 0)
+        return 0;
+
+    if (timeout.count() > 0) {
+        struct pollfd pfd;
+        pfd.fd = m_fd;
+        pfd.events = POLLIN;
+        pfd.revents = 0;
+        if (::poll(&pfd, 1, static_cast<int>(timeout.count())) <= 0)
+            return 0;
+    }
+
+    while (true) {
+        struct sockaddr_nl sender;
+        socklen_t senderLength = sizeof(sender);
+        ssize_t n = recvfrom(m_fd, m_buffer.data(), m_buffer.size() - 1, 0,
+                             reinterpret_cast<struct sockaddr*>(&sender), &senderLength);
+        if (n < 0) {
+            if (errno == EINTR)
+                continue;
+            if (errno == ENOBUFS) {
+                // Ядро відкинуло частину подій - власник має перечитати інвентар повністю
+                m_event = Uevent();
+                m_event.action = "overflow";
+                if (m_handler)
+                    m_handler(m_event);
+                ++dispatched;
+                continue;
+            }
+            break;      // EAGAIN - черга порожня
+        }
+
+        // Лише ядро (nl_pid == 0); інакше будь-який процес міг би підробити hotplug
+        if (sender.nl_pid != 0 || n == 0)
+            continue;
+
+        m_buffer[static_cast<size_t>(n)] = '\0';
+        if (dispatch(m_buffer.data(), static_cast<size_t>(n)))
+            ++dispatched;
+    }
+#else
+    (void)timeout;
+#endif
+    return dispatched;
+}
+
+bool UeventMonitor::inject(const char* message, size_t length)
+{
+    return dispatch(message, length);
+}
@@ -0,0 +1,65 @@
+#ifndef UEVENTMONITOR_H
+#define UEVENTMONITOR_H
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+// ========================================
+// Одна подія ядра (kobject uevent)
+// ========================================
+struct Uevent {
+    std::string action;       // add, remove, change, bind, unbind; "overflow" - події втрачено
+    std::string devpath;      // /devices/pci0000:00/0000:00:1d.0/0000:3d:00.0/nvme/nvme0/nvme0n1
+    std::string subsystem;    // block, pci, drm, hwmon
+    std::string devname;      // nvme0n1, sda1, dri/card0
+    std::string devtype;      // disk, partition, drm_minor
+    std::string pci_slot;     // PCI_SLOT_NAME=0000:01:00.0
+    std::string pci_class;    // PCI_CLASS=30000 (hex; 0x03xxxx - дисплейний контролер)
+};
+
+// ========================================
+// Клас UeventMonitor - hotplug через NETLINK_KOBJECT_UEVENT
+// ========================================
+//
+// Слухає широкомовну групу ядра (без udev і без root) та передає
+// обробнику лише події підсистем block, pci, drm та hwmon. Повідомлення не від
+// ядра (nl_pid != 0) відкидаються. Якщо буфер сокета переповнився
+// (ENOBUFS), обробник отримує подію "overflow" - частину змін втрачено.
+//
+// poll() не блокує за замовчуванням: власник викликає його перед читанням
+// кешованого інвентаря. inject() проганяє синтетичне повідомлення
+// ("add@/devices/...\0ACTION=add\0SUBSYSTEM=block\0...") тим самим шляхом.
+// Не потокобезпечний - виклики poll()/inject() серіалізує власник.
+class UeventMonitor
+{
+public:
+    using Handler = std::function<void(const Uevent& event)>;
+
+    explicit UeventMonitor(Handler handler);
+    ~UeventMonitor();
+
+    UeventMonitor(const UeventMonitor&) = delete;
+    UeventMonitor& operator=(const UeventMonitor&) = delete;
+
+    bool isValid() const;
+
+    // Кількість переданих обробнику подій
+    size_t poll(std::chrono::milliseconds timeout = std::chrono::milliseconds(0));
+    bool inject(const char* message, size_t length);
+
+    // Розбір "action@devpath\0KEY=VALUE\0..."; false - не uevent ядра
+    static bool parse(const char* message, size_t length, Uevent& event);
+
+private:
+    bool dispatch(const char* message, size_t length);
+
+    int m_fd;
+    Handler m_handler;
+    std::vector<char> m_buffer;       // Перевикористовується між poll()
+    Uevent m_event;                   // Рядки перевикористовують ємність
+};
+
+#endif // UEVENTMONITOR_H
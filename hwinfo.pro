@@ -1,4 +1,4 @@
-QT       += core
+QT       += core concurrent
 QT       -= gui
 
 TARGET = hwinfo
@@ -9,10 +9,43 @@ TEMPLATE = app
 
 SOURCES += \
     main.cpp \
-    HardwareInfoProvider.cpp
+    CollectionStats.cpp \
+    DeviceCollector.cpp \
+    DiskFillForecaster.cpp \
+    FleetTable.cpp \
+    HardwareInfoProvider.cpp \
+    MetricRollup.cpp \
+    MountWatcher.cpp \
+    PressureTrigger.cpp \
+    ProcessRunner.cpp \
+    ProcessScanner.cpp \
+    SensorCollector.cpp \
+    SeriesCodec.cpp \
+    SnapshotCodec.cpp \
+    SnapshotLog.cpp \
+    SourceCache.cpp \
+    Tracer.cpp \
+    UeventMonitor.cpp
 
 HEADERS += \
-    HardwareInfoProvider.h
+    CollectionStats.h \
+    DeviceCollector.h \
+    DeviceInfo.h \
+    DiskFillForecaster.h \
+    FleetTable.h \
+    HardwareInfoProvider.h \
+    MetricRollup.h \
+    MountWatcher.h \
+    PressureTrigger.h \
+    ProcessRunner.h \
+    ProcessScanner.h \
+    SensorCollector.h \
+    SeriesCodec.h \
+    SnapshotCodec.h \
+    SnapshotLog.h \
+    SourceCache.h \
+    Tracer.h \
+    UeventMonitor.h
 
 # Windows-specific libraries
 win32 {
@@ -0,0 +1,600 @@
+#include <QCoreApplication>
+#include <QStorageInfo>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <new>
+#include <string>
+#include <thread>
+#include <vector>
+#include "FleetTable.h"
+#include "HardwareInfoProvider.h"
+#include "SeriesCodec.h"
+#include "SnapshotLog.h"
+#include "Tracer.h"
+
+// ========================================
+// hwinfo_bench - розподіл затримок кожної проби HardwareInfoProvider
+// ========================================
+//
+// cold - перший виклик на щойно створеному провайдері (кеші провайдера порожні);
+// warm - повторні виклики на тому самому провайдері після прогріву.
+// Результат - таблиця у stdout та (з --json) JSON-файл для порівняння в review.
+//
+//   hwinfo_bench [--iterations N] [--cold-iterations N] [--filter probe] [--json file]
+//                [--trace file] [--stress-threads N] [--stress-seconds S] [--alloc-check N]
+//                [--fleet N] [--record dir N] [--interval ms] [--series dir]
+//
+// --trace вмикає Tracer на весь прогін і записує Chrome trace_event JSON;
+// виміряні затримки тоді включають вартість трасування.
+//
+// --stress-threads замість вимірів ганяє N потоків на одному провайдері
+// (повний і вибірковий getDeviceInfo, getDisks, getDeviceInfoAsync,
+// invalidateCache). Код виходу 1, якщо потік не завершив жодного виклику або
+// результат розійшовся з еталоном до старту (незмінні поля, порожні
+// незапитані секції, тип кореневого диска). Зібраний з
+// -DHWINFO_SANITIZE_THREAD=ON - перевірка гонок під ThreadSanitizer;
+// ненульовий код виходу, якщо TSan щось знайшов.
+//
+// --alloc-check N рахує operator new за N вибірок collectInto() у той самий
+// ArgentumDevice (усі секції, крім GPU) після прогріву; код виходу 1,
+// якщо усталений цикл алокує.
+//
+// --fleet N завантажує N синтетичних хостів (локальний знімок з випадковими
+// RAM/диском/VRAM) у FleetTable і вимірює типові запити по парку.
+//
+// --record dir N записує N вибірок collectInto() з кроком --interval (1000 ms)
+// у SnapshotLog dir. --series dir кодує числові поля записаних вибірок через
+// SampleSeries: байти на вибірку до/після стиснення по колонках та швидкість
+// декодування всіх колонок (--iterations проходів).
+
+// Лічильник алокацій для --alloc-check
+static std::atomic<uint64_t> g_allocations{ 0 };
+
+void* operator new(size_t size)
+{
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = malloc(size ? size : 1))
+        return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept
+{
+    free(p);
+}
+
+void operator delete(void* p, size_t) noexcept
+{
+    free(p);
+}
+
+namespace {
+
+struct BenchOptions {
+    int iterations = 20;
+    int coldIterations = 5;
+    std::string filter;
+    std::string jsonPath;
+    std::string tracePath;
+    int stressThreads = 0;
+    int stressSeconds = 10;
+    int allocCheckIterations = 0;
+    int fleetHosts = 0;
+    std::string recordDir;
+    int recordSamples = 0;
+    int intervalMs = 1000;
+    std::string seriesDir;
+};
+
+struct ProbeResult {
+    std::string probe;
+    std::string mode;                  // "cold" або "warm"
+    std::vector<double> samplesUs;
+};
+
+// Не дає компілятору викинути результат проби
+volatile size_t g_sink = 0;
+
+double percentile(const std::vector<double>& sorted, double p)
+{
+    if (sorted.empty()) return 0.0;
+    size_t rank = static_cast<size_t>(p / 100.0 * (sorted.size() - 1) + 0.5);
+    return sorted[std::min(rank, sorted.size() - 1)];
+}
+
+double timeUs(const std::function<void(HardwareInfoProvider&)>& probe, HardwareInfoProvider& hw)
+{
+    auto start = std::chrono::steady_clock::now();
+    probe(hw);
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::micro>(end - start).count();
+}
+
+void runProbe(const std::string& name,
+              const std::function<void(HardwareInfoProvider&)>& probe,
+              const BenchOptions& options,
+              std::vector<ProbeResult>& results)
+{
+    if (!options.filter.empty() && name.find(options.filter) == std::string::npos)
+        return;
+
+    // Конструктор провайдера (пошук сенсорів) не входить у вимір
+    ProbeResult cold{ name, "cold", {} };
+    for (int i = 0; i < options.coldIterations; ++i) {
+        HardwareInfoProvider hw;
+        cold.samplesUs.push_back(timeUs(probe, hw));
+    }
+    results.push_back(cold);
+
+    ProbeResult warm{ name, "warm", {} };
+    HardwareInfoProvider hw;
+    probe(hw);
+    for (int i = 0; i < options.iterations; ++i) {
+        warm.samplesUs.push_back(timeUs(probe, hw));
+    }
+    results.push_back(warm);
+}
+
+void printTable(const std::vector<ProbeResult>& results)
+{
+    std::cout << std::left << std::setw(30) << "probe" << std::setw(6) << "mode"
+        << std::right << std::setw(6) << "n"
+        << std::setw(12) << "min us" << std::setw(12) << "p50 us"
+        << std::setw(12) << "p90 us" << std::setw(12) << "p99 us"
+        << std::setw(12) << "max us" << std::endl;
+
+    for (const ProbeResult& result : results) {
+        std::vector<double> sorted = result.samplesUs;
+        std::sort(sorted.begin(), sorted.end());
+        std::cout << std::left << std::setw(30) << result.probe << std::setw(6) << result.mode
+            << std::right << std::setw(6) << sorted.size()
+            << std::fixed << std::setprecision(1)
+            << std::setw(12) << (sorted.empty() ? 0.0 : sorted.front())
+            << std::setw(12) << percentile(sorted, 50)
+            << std::setw(12) << percentile(sorted, 90)
+            << std::setw(12) << percentile(sorted, 99)
+            << std::setw(12) << (sorted.empty() ? 0.0 : sorted.back()) << std::endl;
+    }
+}
+
+bool writeJson(const std::string& path, const std::vector<ProbeResult>& results)
+{
+    std::ofstream out(path);
+    if (!out.is_open())
+        return false;
+
+    out << "{\n  \"results\": [\n";
+    for (size_t i = 0; i < results.size(); ++i) {
+        const ProbeResult& result = results[i];
+        std::vector<double> sorted = result.samplesUs;
+        std::sort(sorted.begin(), sorted.end());
+        double mean = 0.0;
+        for (double sample : sorted) mean += sample;
+        if (!sorted.empty()) mean /= sorted.size();
+
+        out << std::fixed << std::setprecision(1)
+            << "    {\"probe\": \"" << result.probe << "\", \"mode\": \"" << result.mode << "\""
+            << ", \"iterations\": " << sorted.size()
+            << ", \"min_us\": " << (sorted.empty() ? 0.0 : sorted.front())
+            << ", \"mean_us\": " << mean
+            << ", \"p50_us\": " << percentile(sorted, 50)
+            << ", \"p90_us\": " << percentile(sorted, 90)
+            << ", \"p99_us\": " << percentile(sorted, 99)
+            << ", \"max_us\": " << (sorted.empty() ? 0.0 : sorted.back()) << "}"
+            << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    out << "  ]\n}\n";
+    return true;
+}
+
+int runStress(const BenchOptions& options, const QString& rootDevice)
+{
+    HardwareInfoProvider hw;
+    std::atomic<bool> stop{ false };
+    std::atomic<size_t> sink{ 0 };
+    std::vector<uint64_t> iterations(static_cast<size_t>(options.stressThreads), 0);
+
+    // Еталон до старту потоків: незмінні поля та порожні незапитані секції
+    // мають збігатися в кожному виклику, інакше потоки бачать чужий стан
+    const ArgentumDevice reference = hw.getDeviceInfo();
+    const QString referenceDiskType = hw.getDiskType(rootDevice);
+    std::atomic<uint64_t> mismatches[5] = {};
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < options.stressThreads; ++t) {
+        threads.emplace_back([&, t] {
+            uint64_t count = 0;
+            size_t local = 0;
+            while (!stop.load(std::memory_order_relaxed)) {
+                // Зсув на номер потоку - різні потоки одночасно в різних пробах
+                const size_t probe = static_cast<size_t>((count + static_cast<uint64_t>(t)) % 5);
+                bool ok = true;
+                switch (probe) {
+                case 0: {
+                    ArgentumDevice device = hw.getDeviceInfo();
+                    ok = device.ram_mb == reference.ram_mb && device.cpu_cores == reference.cpu_cores &&
+                         device.cpu_model == reference.cpu_model;
+                    local += device.disks.size();
+                    break;
+                }
+                case 1: {
+                    ArgentumDevice device = hw.getDeviceInfo(DeviceField::RAM | DeviceField::DiskIO | DeviceField::Network);
+                    ok = device.ram_mb == reference.ram_mb && !device.cpu_model.has_value() && device.disks.empty();
+                    local += device.ram_mb;
+                    break;
+                }
+                case 2:
+                    local += hw.getDisks().size();
+                    break;
+                case 3: {
+                    ArgentumDevice device = hw.getDeviceInfoAsync(DeviceField::Power | DeviceField::Sensors).result();
+                    ok = device.ram_mb == 0 && device.disks.empty();
+                    local += device.sensors.size();
+                    break;
+                }
+                default: {
+                    hw.invalidateCache("cmd:lsblk");
+                    const QString type = hw.getDiskType(rootDevice);
+                    ok = type == referenceDiskType;
+                    local += type.size();
+                    break;
+                }
+                }
+                if (!ok)
+                    mismatches[probe].fetch_add(1, std::memory_order_relaxed);
+                ++count;
+            }
+            iterations[static_cast<size_t>(t)] = count;
+            sink.fetch_add(local, std::memory_order_relaxed);
+        });
+    }
+
+    std::this_thread::sleep_for(std::chrono::seconds(options.stressSeconds));
+    stop.store(true);
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    g_sink = g_sink + sink.load();
+
+    uint64_t total = 0;
+    int failures = 0;
+    for (size_t t = 0; t < iterations.size(); ++t) {
+        total += iterations[t];
+        if (iterations[t] == 0) {
+            std::cout << "FAIL: stress thread " << t << " completed no calls" << std::endl;
+            ++failures;
+        }
+    }
+    static const char* const probeNames[5] = {
+        "getDeviceInfo()", "getDeviceInfo(RAM|DiskIO|Network)", "getDisks()",
+        "getDeviceInfoAsync(Power|Sensors)", "getDiskType()"
+    };
+    for (size_t probe = 0; probe < 5; ++probe) {
+        if (uint64_t count = mismatches[probe].load()) {
+            std::cout << "FAIL: " << probeNames[probe] << " differed from the reference " << count << " time(s)" << std::endl;
+            ++failures;
+        }
+    }
+
+    SourceCache::Stats cache = hw.getCacheStats();
+    std::cout << "stress: " << options.stressThreads << " threads, " << options.stressSeconds << " s, "
+        << total << " calls; cache " << cache.hits << " hit(s), " << cache.misses << " miss(es), "
+        << cache.coalesced << " coalesced" << std::endl;
+    return failures == 0 ? 0 : 1;
+}
+
+int runAllocCheck(const BenchOptions& options)
+{
+    HardwareInfoProvider hw;
+    CollectOptions sampling;
+    sampling.fields &= ~static_cast<uint32_t>(DeviceField::GPU);
+
+    // Прогрів: перелік томів, зони RAPL, ємність рядків та векторів
+    ArgentumDevice device;
+    for (int i = 0; i < 3; ++i) {
+        hw.collectInto(device, sampling);
+    }
+
+    uint64_t before = g_allocations.load();
+    for (int i = 0; i < options.allocCheckIterations; ++i) {
+        hw.collectInto(device, sampling);
+        g_sink = g_sink + device.network.size();
+    }
+    uint64_t allocations = g_allocations.load() - before;
+
+    std::cout << "alloc-check: " << options.allocCheckIterations << " collectInto() call(s), "
+        << allocations << " allocation(s)" << std::endl;
+    return allocations == 0 ? 0 : 1;
+}
+
+int runFleet(const BenchOptions& options)
+{
+    HardwareInfoProvider hw;
+    const ArgentumDevice local = hw.getDeviceInfo();
+    const char* const gpuModels[] = { "NVIDIA GeForce RTX 3060", "NVIDIA GeForce RTX 4090",
+                                      "AMD Radeon RX 6600 XT", "Intel Arc A770" };
+
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<double> percent(0.0, 100.0);
+    FleetTable table;
+    table.reserve(static_cast<size_t>(options.fleetHosts));
+
+    auto loadStart = std::chrono::steady_clock::now();
+    for (int i = 0; i < options.fleetHosts; ++i) {
+        ArgentumDevice host = local;
+        host.ram_usage_percent = percent(rng);
+        for (DiskInfo& disk : host.disks) {
+            disk.usage_percent = percent(rng);
+        }
+        GPUInfo gpu;
+        gpu.model = gpuModels[i % 4];
+        gpu.vram_mb = 8192;
+        gpu.vram_free_mb = static_cast<uint64_t>(percent(rng) * 81.92);
+        host.gpus.assign(1, gpu);
+        table.append(host);
+    }
+    double loadMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - loadStart).count();
+
+    std::vector<ProbeResult> results;
+    auto measure = [&](const std::string& name, const std::function<size_t()>& query) {
+        ProbeResult result{ name, "warm", {} };
+        for (int i = 0; i < options.iterations; ++i) {
+            auto start = std::chrono::steady_clock::now();
+            g_sink = g_sink + query();
+            result.samplesUs.push_back(std::chrono::duration<double, std::micro>(
+                std::chrono::steady_clock::now() - start).count());
+        }
+        results.push_back(result);
+    };
+
+    const FleetTable::HostColumns& hosts = table.hosts();
+    measure("fleet ram p50/p99", [&] {
+        return FleetTable::quantiles(hosts.ram_usage_percent, nullptr, { 0.5, 0.99 }).size();
+    });
+    measure("fleet filter+p50", [&] {
+        FleetTable::Mask mask = FleetTable::selectAll(table.hostCount());
+        FleetTable::filterEquals(hosts.os, table.strings().find(local.os), mask);
+        FleetTable::filterRange(hosts.ram_usage_percent, 50.0, 100.0, mask);
+        return FleetTable::quantiles(hosts.ram_usage_percent, &mask, { 0.5 }).size();
+    });
+    measure("fleet disk usage by type", [&] {
+        return FleetTable::groupBy(table.disks().type, table.disks().usage_percent, nullptr, { 0.5, 0.99 }).size();
+    });
+    measure("fleet vram free by model", [&] {
+        return FleetTable::groupBy(table.gpus().model, table.gpus().vram_free_mb, nullptr, { 0.1, 0.5 }).size();
+    });
+
+    std::cout << "fleet: " << table.hostCount() << " hosts, " << table.diskCount() << " disks, "
+        << table.gpuCount() << " GPUs loaded in " << std::fixed << std::setprecision(1) << loadMs << " ms" << std::endl;
+    printTable(results);
+    if (!options.jsonPath.empty() && !writeJson(options.jsonPath, results)) {
+        std::cerr << "Cannot write " << options.jsonPath << std::endl;
+        return 1;
+    }
+    return 0;
+}
+
+int runRecord(const BenchOptions& options)
+{
+    SnapshotLog log(options.recordDir);
+    if (!log.open()) {
+        std::cerr << "Cannot open " << options.recordDir << std::endl;
+        return 1;
+    }
+
+    HardwareInfoProvider hw;
+    ArgentumDevice device;
+    auto next = std::chrono::steady_clock::now();
+    for (int i = 0; i < options.recordSamples; ++i) {
+        std::this_thread::sleep_until(next);
+        next += std::chrono::milliseconds(options.intervalMs);
+
+        hw.collectInto(device);
+        const int64_t nowMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+        if (!log.append(nowMs, device)) {
+            std::cerr << "Cannot append to " << options.recordDir << std::endl;
+            return 1;
+        }
+    }
+    log.flush();
+
+    const SnapshotLog::Stats stats = log.stats();
+    std::cout << "record: " << stats.records << " sample(s) in " << stats.segments << " segment(s), "
+        << stats.bytes << " bytes" << std::endl;
+    return 0;
+}
+
+int runSeries(const BenchOptions& options)
+{
+    SnapshotLog log(options.seriesDir);
+    if (!log.open()) {
+        std::cerr << "Cannot open " << options.seriesDir << std::endl;
+        return 1;
+    }
+
+    SampleSeries series;
+    ArgentumDevice device;
+    uint64_t snapshotBytes = 0;
+    size_t corrupted = 0;
+    auto encodeStart = std::chrono::steady_clock::now();
+    log.read(INT64_MIN, INT64_MAX, [&](const SnapshotRecord& record) {
+        if (!SnapshotLog::decode(record, device)) {
+            ++corrupted;
+            return true;
+        }
+        snapshotBytes += record.size;
+        series.append(record.timestamp_ms, device);
+        return true;
+    });
+    double encodeMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - encodeStart).count();
+
+    const size_t samples = series.sampleCount();
+    if (samples == 0) {
+        std::cerr << "No samples in " << options.seriesDir << " (use --record first)" << std::endl;
+        return 1;
+    }
+
+    // Сирі числові поля: 8 байтів на значення та на мітку часу
+    const uint64_t values = series.valueCount();
+    const double rawPerSample = double(values + samples) * 8.0 / samples;
+    const double encodedPerSample = double(series.sizeBytes()) / samples;
+
+    std::cout << "series: " << samples << " sample(s), " << series.columns().size() << " column(s), "
+        << values << " value(s)";
+    if (corrupted > 0)
+        std::cout << ", " << corrupted << " undecodable record(s) skipped";
+    std::cout << std::endl << std::fixed << std::setprecision(1)
+        << "  snapshot (SnapshotCodec) " << std::setw(10) << double(snapshotBytes) / samples << " B/sample" << std::endl
+        << "  numeric fields, raw      " << std::setw(10) << rawPerSample << " B/sample" << std::endl
+        << "  numeric fields, encoded  " << std::setw(10) << encodedPerSample << " B/sample ("
+        << std::setprecision(2) << series.sizeBytes() * 8.0 / (values + samples) << " bits/value, "
+        << std::setprecision(1) << rawPerSample / encodedPerSample << "x)" << std::endl
+        << "  encode (incl. decode of log records) " << encodeMs << " ms" << std::endl;
+
+    std::cout << std::left << std::setw(48) << "column" << std::right << std::setw(12) << "B/sample" << std::endl;
+    std::cout << std::left << std::setw(48) << "timestamp" << std::right << std::setw(12)
+        << std::setprecision(3) << double(series.timestamps().sizeBytes()) / samples << std::endl;
+    for (const SampleSeries::Column& column : series.columns()) {
+        std::cout << std::left << std::setw(48) << column.name << std::right << std::setw(12)
+            << double(column.sizeBytes()) / column.count() << std::endl;
+    }
+
+    // Один прохід - декодування всіх колонок
+    ProbeResult decode{ "series decode (all columns)", "warm", {} };
+    for (int i = 0; i < options.iterations; ++i) {
+        auto start = std::chrono::steady_clock::now();
+        int64_t integer = 0;
+        double real = 0.0;
+        IntegerSeriesDecoder timestamps(series.timestamps().data(), series.timestamps().sizeBytes(), samples);
+        while (timestamps.next(integer)) g_sink = g_sink + static_cast<size_t>(integer);
+        for (const SampleSeries::Column& column : series.columns()) {
+            if (column.integer) {
+                IntegerSeriesDecoder decoder(column.integers.data(), column.integers.sizeBytes(), column.count());
+                while (decoder.next(integer)) g_sink = g_sink + static_cast<size_t>(integer);
+            } else {
+                DoubleSeriesDecoder decoder(column.doubles.data(), column.doubles.sizeBytes(), column.count());
+                while (decoder.next(real)) g_sink = g_sink + (real > 0.0);
+            }
+        }
+        decode.samplesUs.push_back(std::chrono::duration<double, std::micro>(
+            std::chrono::steady_clock::now() - start).count());
+    }
+
+    std::vector<ProbeResult> results{ decode };
+    printTable(results);
+    std::vector<double> sorted = decode.samplesUs;
+    std::sort(sorted.begin(), sorted.end());
+    const double p50Us = percentile(sorted, 50);
+    if (p50Us > 0.0) {
+        std::cout << std::setprecision(1) << "decode throughput (p50): "
+            << (values + samples) / p50Us << " M values/s, " << samples / p50Us << " M samples/s" << std::endl;
+    }
+    if (!options.jsonPath.empty() && !writeJson(options.jsonPath, results)) {
+        std::cerr << "Cannot write " << options.jsonPath << std::endl;
+        return 1;
+    }
+    return 0;
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    QCoreApplication app(argc, argv);
+
+    BenchOptions options;
+    for (int i = 1; i < argc; ++i) {
+        bool hasValue = i + 1 < argc;
+        if (strcmp(argv[i], "--iterations") == 0 && hasValue) options.iterations = std::max(1, atoi(argv[++i]));
+        else if (strcmp(argv[i], "--cold-iterations") == 0 && hasValue) options.coldIterations = std::max(1, atoi(argv[++i]));
+        else if (strcmp(argv[i], "--filter") == 0 && hasValue) options.filter = argv[++i];
+        else if (strcmp(argv[i], "--json") == 0 && hasValue) options.jsonPath = argv[++i];
+        else if (strcmp(argv[i], "--trace") == 0 && hasValue) options.tracePath = argv[++i];
+        else if (strcmp(argv[i], "--stress-threads") == 0 && hasValue) options.stressThreads = std::max(1, atoi(argv[++i]));
+        else if (strcmp(argv[i], "--stress-seconds") == 0 && hasValue) options.stressSeconds = std::max(1, atoi(argv[++i]));
+        else if (strcmp(argv[i], "--alloc-check") == 0 && hasValue) options.allocCheckIterations = std::max(1, atoi(argv[++i]));
+        else if (strcmp(argv[i], "--fleet") == 0 && hasValue) options.fleetHosts = std::max(1, atoi(argv[++i]));
+        else if (strcmp(argv[i], "--record") == 0 && i + 2 < argc) {
+            options.recordDir = argv[++i];
+            options.recordSamples = std::max(1, atoi(argv[++i]));
+        }
+        else if (strcmp(argv[i], "--interval") == 0 && hasValue) options.intervalMs = std::max(1, atoi(argv[++i]));
+        else if (strcmp(argv[i], "--series") == 0 && hasValue) options.seriesDir = argv[++i];
+        else {
+            std::cerr << "Usage: hwinfo_bench [--iterations N] [--cold-iterations N]"
+                " [--filter probe] [--json file] [--trace file]"
+                " [--stress-threads N] [--stress-seconds S] [--alloc-check N] [--fleet N]"
+                " [--record dir N] [--interval ms] [--series dir]" << std::endl;
+            return 2;
+        }
+    }
+
+    Tracer::setEnabled(!options.tracePath.empty());
+
+    // Пристрій кореневої ФС для проби типу диску
+    const QString rootDevice = QString::fromLatin1(QStorageInfo("/").device());
+
+    if (options.stressThreads > 0)
+        return runStress(options, rootDevice);
+    if (options.allocCheckIterations > 0)
+        return runAllocCheck(options);
+    if (options.fleetHosts > 0)
+        return runFleet(options);
+    if (options.recordSamples > 0)
+        return runRecord(options);
+    if (!options.seriesDir.empty())
+        return runSeries(options);
+
+    std::vector<ProbeResult> results;
+    runProbe("getCPUName", [](HardwareInfoProvider& hw) {
+        g_sink = g_sink + hw.getCPUName().size();
+    }, options, results);
+    runProbe("getTotalRAM", [](HardwareInfoProvider& hw) {
+        g_sink = g_sink + hw.getTotalRAM();
+    }, options, results);
+    runProbe("getDisks", [](HardwareInfoProvider& hw) {
+        g_sink = g_sink + hw.getDisks().size();
+    }, options, results);
+    runProbe("getGPUList", [](HardwareInfoProvider& hw) {
+        g_sink = g_sink + hw.getGPUList().size();
+    }, options, results);
+    runProbe("getDiskType", [&rootDevice](HardwareInfoProvider& hw) {
+        g_sink = g_sink + hw.getDiskType(rootDevice).size();
+    }, options, results);
+    runProbe("getDeviceInfo", [](HardwareInfoProvider& hw) {
+        g_sink = g_sink + hw.getDeviceInfo().disks.size();
+    }, options, results);
+    runProbe("getDeviceInfo(RAM)", [](HardwareInfoProvider& hw) {
+        g_sink = g_sink + hw.getDeviceInfo(DeviceField::RAM).ram_mb;
+    }, options, results);
+    runProbe("getDeviceInfo(RAM|DiskSpace)", [](HardwareInfoProvider& hw) {
+        g_sink = g_sink + hw.getDeviceInfo(DeviceField::RAM | DeviceField::DiskSpace).free_disk_mb.value_or(0);
+    }, options, results);
+    runProbe("collectInto", [](HardwareInfoProvider& hw) {
+        static ArgentumDevice device;     // Той самий device між викликами - як у циклі вибірок
+        hw.collectInto(device);
+        g_sink = g_sink + device.disks.size();
+    }, options, results);
+
+    printTable(results);
+
+    if (!options.jsonPath.empty() && !writeJson(options.jsonPath, results)) {
+        std::cerr << "Cannot write " << options.jsonPath << std::endl;
+        return 1;
+    }
+    if (!options.tracePath.empty() && !Tracer::writeChromeTrace(options.tracePath)) {
+        std::cerr << "Cannot write " << options.tracePath << std::endl;
+        return 1;
+    }
+    return 0;
+}
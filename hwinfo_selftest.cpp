@@ -0,0 +1,1059 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <new>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#ifdef __linux__
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+#include "DeviceCollector.h"
+#include "DiskFillForecaster.h"
+#include "FleetTable.h"
+#include "ProcessScanner.h"
+#include "SeriesCodec.h"
+#include "SnapshotLog.h"
+#include "SourceCache.h"
+
+// ========================================
+// hwinfo_selftest - перевірки hwinfo_core без Qt для ctest
+// ========================================
+//
+//   hwinfo_selftest uevents
+//   hwinfo_selftest cache
+//   hwinfo_selftest codec [iterations] [seed]
+//   hwinfo_selftest snapshotlog
+//   hwinfo_selftest fleet [iterations] [seed]
+//   hwinfo_selftest forecast
+//   hwinfo_selftest stress [threads] [seconds]
+//   hwinfo_selftest alloc [iterations]
+//   hwinfo_selftest scan [processes] [iterations]
+//
+// Кожен режим друкує FAIL на кожну невиконану перевірку і завершується з
+// кодом 1, якщо хоч одна не пройшла.
+//
+// uevents проганяє синтетичні події через DeviceCollector::injectUevent()
+// і перевіряє, що block інвалідує disktype:<цілий диск> (разом із типами його
+// розділів NVMe/MMC) та cmd:lsblk і скидає типи томів, drm та дисплейний
+// PCI - cmd:lspci, hwmon та drm add/remove
+// позначають сенсори для перешуку, а решта записів кешу лишається.
+//
+// cache перевіряє злиття запитів SourceCache::get(): виняток з fetch не лишає
+// очікувачів висіти, а fetch, скасований власником, очікувачі повторюють самі.
+//
+// codec кодує N (2000) випадкових рядів IntegerSeriesEncoder і
+// DoubleSeriesEncoder - межі int64, NaN, ±0, нескінченності, випадкові біти,
+// повтори та дрібні кроки - і порівнює декодоване побітово. Зерно
+// друкується, тож провал відтворюється. Окремо - колонки SampleSeries для
+// сенсорів з однаковими chip/label.
+//
+// snapshotlog пише записи в журнал у тимчасовому каталозі, псує хвіст
+// сегмента до high_water, відкриває знову і перевіряє recovered_bytes, число
+// та вміст прочитаних записів, дописування після відновлення, а потім
+// ротацію з max_segments - видалення найстаріших сегментів.
+//
+// fleet рахує FleetTable::quantiles() і groupBy() на N (500) випадкових
+// колонках з NaN і масками, коротшими й довшими за колонку, і порівнює з
+// наївним сортуванням вибраних значень.
+//
+// forecast годує DiskFillForecaster синтетичними вибірками: ETA лінійного
+// заповнення в межах 1%, одне сповіщення, поки використання коливається між
+// clear і fire, і зняття сповіщення зниклої точки монтування після forget_after.
+//
+// stress ганяє потоки (8 за замовчуванням, 3 s) на одному DeviceCollector:
+// повний і вибірковий collect(), collectInto() у власний ArgentumDevice,
+// volumes(true), diskType() після invalidateCache("cmd:lsblk") та
+// injectUevent() block і hwmon (перешук сенсорів під час читань). Кожен
+// результат порівнюється з еталоном до старту: незмінні поля та порожні
+// незапитані секції. Зібраний з
+// -DHWINFO_SANITIZE_THREAD=ON - ще й перевірка гонок під ThreadSanitizer.
+//
+// alloc рахує operator new за N (1000) вибірок DeviceCollector::collectInto()
+// у той самий ArgentumDevice (усі секції, крім GPU) після прогріву - як
+// hwinfo_bench --alloc-check, але без Qt; провал, якщо усталений цикл алокує.
+//
+// scan доводить кількість процесів у системі до N (20000) сплячими дочірніми
+// процесами і міряє ProcessScanner::scan(10, CPU) за --iterations (20)
+// повторних сканів: min/p50/max. Провал, якщо скан бачить менше процесів,
+// ніж їх створено, або топ-N порожній.
+
+// Лічильник алокацій для alloc
+static std::atomic<uint64_t> g_allocations{ 0 };
+
+void* operator new(size_t size)
+{
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = malloc(size ? size : 1))
+        return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept
+{
+    free(p);
+}
+
+void operator delete(void* p, size_t) noexcept
+{
+    free(p);
+}
+
+namespace {
+
+int g_failures = 0;
+
+void check(bool condition, const std::string& what)
+{
+    if (!condition) {
+        std::cout << "FAIL: " << what << std::endl;
+        ++g_failures;
+    }
+}
+
+// "add@/devices/...\0ACTION=add\0SUBSYSTEM=block\0..." - як у NETLINK_KOBJECT_UEVENT
+std::string uevent(const std::string& action, const std::string& devpath,
+                   const std::string& subsystem, const std::string& extra = std::string())
+{
+    std::string message = action + "@" + devpath;
+    message.push_back('\0');
+    for (const std::string& field : { "ACTION=" + action, "DEVPATH=" + devpath, "SUBSYSTEM=" + subsystem }) {
+        message += field;
+        message.push_back('\0');
+    }
+    size_t start = 0;
+    while (start < extra.size()) {
+        size_t end = extra.find(' ', start);
+        if (end == std::string::npos) end = extra.size();
+        message.append(extra, start, end - start);
+        message.push_back('\0');
+        start = end + 1;
+    }
+    return message;
+}
+
+// Ключі, які справді пишуть diskType() (за цілим диском) та runCachedCommand()
+std::vector<std::string> inventoryKeys(const DeviceCollector& collector)
+{
+    return {
+        collector.diskTypeKey("/dev/sda"),
+        collector.diskTypeKey("/dev/sdb"),
+        collector.diskTypeKey("/dev/nvme0n1p2"),
+        collector.diskTypeKey("/dev/nvme1n1"),
+        collector.diskTypeKey("/dev/mmcblk0p1"),
+        "cmd:lsblk -d -o NAME,ROTA,TRAN,TYPE,MODEL",
+        "cmd:lspci -v",
+    };
+}
+
+void fillCache(DeviceCollector& collector)
+{
+    for (const std::string& key : inventoryKeys(collector))
+        collector.cache().store(key, "cached", std::chrono::hours(1));
+    collector.volumes(false);       // Скидає прапорець типів томів
+    collector.sensors();            // Перешукує сенсори, якщо треба
+}
+
+bool cached(DeviceCollector& collector, const std::string& key)
+{
+    std::string value;
+    return collector.cache().lookup(key, value);
+}
+
+// expected - ключі, які подія має інвалідувати
+void expectInvalidated(DeviceCollector& collector, const std::string& name,
+                       const std::vector<std::string>& expected, bool volumeTypesStale, bool sensorsStale)
+{
+    for (const std::string& key : inventoryKeys(collector)) {
+        bool invalidated = false;
+        for (const std::string& prefix : expected)
+            invalidated = invalidated || key.compare(0, prefix.size(), prefix) == 0;
+        check(cached(collector, key) != invalidated,
+              name + ": " + key + (invalidated ? " not invalidated" : " invalidated"));
+    }
+    check(collector.volumeTypesStale() == volumeTypesStale,
+          name + ": volume types " + (volumeTypesStale ? "not marked stale" : "marked stale"));
+    check(collector.sensorsStale() == sensorsStale,
+          name + ": sensors " + (sensorsStale ? "not marked for rediscovery" : "marked for rediscovery"));
+}
+
+int runUevents()
+{
+#ifdef __linux__
+    DeviceCollector collector;
+
+    // Розділи діляться ключем з цілим диском - інакше подія диска їх не скине
+    check(collector.diskTypeKey("/dev/nvme0n1p2") == "disktype:nvme0n1", "disk key: nvme partition");
+    check(collector.diskTypeKey("nvme0n1") == "disktype:nvme0n1", "disk key: nvme disk");
+    check(collector.diskTypeKey("/dev/mmcblk0p1") == "disktype:mmcblk0", "disk key: mmc partition");
+    check(collector.diskTypeKey("/dev/sda1") == "disktype:sda", "disk key: sd partition");
+
+    // Формат ключа runCachedCommand() - той самий, що в inventoryKeys()
+    std::string output;
+    collector.runCachedCommand("true", { "-v" }, 1000, std::chrono::hours(1), output);
+    check(cached(collector, "cmd:true -v"), "command key: cmd:true -v not cached");
+
+    fillCache(collector);
+    check(collector.injectUevent(uevent("add", "/devices/pci0000:00/0000:00:17.0/ata1/host0/target0:0:0/0:0:0:0/block/sda",
+                                        "block", "DEVNAME=sda DEVTYPE=disk")),
+          "block disk: event not accepted");
+    expectInvalidated(collector, "block disk", { "disktype:sda", "cmd:lsblk" }, true, false);
+
+    // Розділ інвалідує свій цілий диск
+    fillCache(collector);
+    check(collector.injectUevent(uevent("change", "/devices/pci0000:00/0000:00:1d.0/0000:3d:00.0/nvme/nvme0/nvme0n1/nvme0n1p2",
+                                        "block", "DEVNAME=nvme0n1p2 DEVTYPE=partition")),
+          "block partition: event not accepted");
+    expectInvalidated(collector, "block partition", { "disktype:nvme0n1", "cmd:lsblk" }, true, false);
+
+    // Подія цілого NVMe-диска скидає закешований тип його розділу, але не nvme1n1
+    fillCache(collector);
+    check(collector.injectUevent(uevent("change", "/devices/pci0000:00/0000:00:1d.0/0000:3d:00.0/nvme/nvme0/nvme0n1",
+                                        "block", "DEVNAME=nvme0n1 DEVTYPE=disk")),
+          "block nvme disk: event not accepted");
+    expectInvalidated(collector, "block nvme disk", { "disktype:nvme0n1", "cmd:lsblk" }, true, false);
+
+    fillCache(collector);
+    check(collector.injectUevent(uevent("remove", "/devices/platform/soc/fe340000.mmc/mmc_host/mmc0/mmc0:0001/block/mmcblk0",
+                                        "block", "DEVNAME=mmcblk0 DEVTYPE=disk")),
+          "block mmc disk: event not accepted");
+    expectInvalidated(collector, "block mmc disk", { "disktype:mmcblk0", "cmd:lsblk" }, true, false);
+
+    fillCache(collector);
+    check(collector.injectUevent(uevent("add", "/devices/pci0000:00/0000:00:02.0/drm/card1",
+                                        "drm", "DEVNAME=dri/card1 DEVTYPE=drm_minor")),
+          "drm: event not accepted");
+    expectInvalidated(collector, "drm", { "cmd:lspci" }, false, true);
+
+    fillCache(collector);
+    check(collector.injectUevent(uevent("bind", "/devices/pci0000:00/0000:00:01.0/0000:01:00.0",
+                                        "pci", "PCI_CLASS=30000 PCI_SLOT_NAME=0000:01:00.0")),
+          "pci display: event not accepted");
+    expectInvalidated(collector, "pci display", { "cmd:lspci" }, false, false);
+
+    // Мережева карта - не дисплейний контролер, інвентар не чіпається
+    fillCache(collector);
+    collector.injectUevent(uevent("bind", "/devices/pci0000:00/0000:00:1c.0/0000:02:00.0",
+                                  "pci", "PCI_CLASS=20000 PCI_SLOT_NAME=0000:02:00.0"));
+    expectInvalidated(collector, "pci network", {}, false, false);
+
+    // hwmon драйвера: лише перешук сенсорів, і зникає з наступним читанням
+    fillCache(collector);
+    check(collector.injectUevent(uevent("add", "/devices/pci0000:00/0000:00:1d.0/0000:3d:00.0/nvme/nvme0/hwmon3", "hwmon")),
+          "hwmon add: event not accepted");
+    expectInvalidated(collector, "hwmon add", {}, false, true);
+    collector.sensors();
+    check(!collector.sensorsStale(), "hwmon add: sensors() did not rediscover");
+
+    fillCache(collector);
+    collector.injectUevent(uevent("change", "/devices/platform/coretemp.0/hwmon/hwmon1", "hwmon"));
+    expectInvalidated(collector, "hwmon change", {}, false, false);
+
+    fillCache(collector);
+    check(collector.injectUevent(uevent("remove", "/devices/pci0000:00/0000:00:1d.0/0000:3d:00.0/nvme/nvme0/hwmon3", "hwmon")),
+          "hwmon remove: event not accepted");
+    expectInvalidated(collector, "hwmon remove", {}, false, true);
+
+    fillCache(collector);
+    check(!collector.injectUevent(uevent("add", "/devices/virtual/net/veth0", "net", "INTERFACE=veth0")),
+          "net: untracked subsystem accepted");
+    expectInvalidated(collector, "net", {}, false, false);
+
+    std::cout << "uevents: " << (g_failures == 0 ? "ok" : "failed") << std::endl;
+    return g_failures == 0 ? 0 : 1;
+#else
+    std::cout << "uevents: skipped (Linux only)" << std::endl;
+    return 0;
+#endif
+}
+
+// Власник fetch кидає виняток або скасовує свій збір, поки другий потік чекає
+// на той самий ключ: очікувач не має зависнути, а скасування - стати його Failed
+int runCacheCheck()
+{
+    using namespace std::chrono_literals;
+
+    struct Waiter {
+        SourceCache::Lookup lookup = SourceCache::Lookup::Failed;
+        std::string value;
+    };
+
+    // fetch власника стартує, чекає, поки очікувач стане в чергу, і завершується end()
+    auto race = [](SourceCache& cache, const std::string& key, const std::function<bool(std::string&)>& end,
+                   const SourceCache::CancelCheck& isCanceled, Waiter& waiter) {
+        std::atomic<bool> started{ false };
+        std::thread owner([&] {
+            try {
+                std::string value;
+                cache.get(key, 1h, [&](std::string& fetched) {
+                    started = true;
+                    std::this_thread::sleep_for(100ms);
+                    return end(fetched);
+                }, value, isCanceled);
+            }
+            catch (const std::runtime_error&) {
+            }
+        });
+        while (!started)
+            std::this_thread::yield();
+        waiter.lookup = cache.get(key, 1h, [](std::string& fetched) {
+            fetched = "waiter";
+            return true;
+        }, waiter.value);
+        owner.join();
+    };
+
+    SourceCache cache;
+    Waiter waiter;
+    bool thrown = false;
+    race(cache, "throw", [&thrown](std::string&) -> bool {
+        thrown = true;
+        throw std::runtime_error("fetch");
+    }, SourceCache::CancelCheck(), waiter);
+    check(thrown, "throw: fetch did not run");
+    check(waiter.lookup != SourceCache::Lookup::Coalesced, "throw: waiter coalesced with a thrown fetch");
+
+    std::string value;
+    SourceCache::Lookup after = cache.get("throw", 1h, [](std::string& fetched) {
+        fetched = "retry";
+        return true;
+    }, value);
+    check(after != SourceCache::Lookup::Failed, "throw: key still failing after the exception");
+
+    // Скасований збір власника - не збій для очікувача: той запитує сам
+    race(cache, "cancel", [](std::string&) { return false; }, [] { return true; }, waiter);
+    check(waiter.lookup == SourceCache::Lookup::Fetched && waiter.value == "waiter",
+          "cancel: waiter did not retry the canceled fetch");
+    check(cache.lookup("cancel", value) && value == "waiter", "cancel: retried value not cached");
+
+    // Звичайний збій і далі спільний для всіх, хто чекав
+    race(cache, "fail", [](std::string&) { return false; }, [] { return false; }, waiter);
+    check(waiter.lookup == SourceCache::Lookup::Failed || waiter.lookup == SourceCache::Lookup::Fetched,
+          "fail: unexpected waiter result");
+
+    std::cout << "cache: " << (g_failures == 0 ? "ok" : "failed") << std::endl;
+    return g_failures == 0 ? 0 : 1;
+}
+
+int runStress(int threadCount, int seconds)
+{
+    DeviceCollector collector;
+
+    std::string rootDevice;
+    for (const VolumeInfo& volume : collector.volumes(false)) {
+        if (volume.mount_point == "/")
+            rootDevice = volume.device;
+    }
+
+    const ArgentumDevice reference = collector.collect();
+    const DiskType referenceDiskType = collector.diskType(rootDevice);
+    const std::string blockEvent = uevent("change", "/devices/virtual/block/loop0", "block", "DEVNAME=loop0 DEVTYPE=disk");
+    const std::string hwmonEvent = uevent("add", "/devices/virtual/thermal/thermal_zone0/hwmon0", "hwmon");
+
+    const size_t kProbes = 6;
+    std::atomic<bool> stop{ false };
+    std::atomic<uint64_t> mismatches[kProbes] = {};
+    std::vector<uint64_t> iterations(static_cast<size_t>(threadCount), 0);
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < threadCount; ++t) {
+        threads.emplace_back([&, t] {
+            ArgentumDevice own;
+            uint64_t count = 0;
+            while (!stop.load(std::memory_order_relaxed)) {
+                // Зсув на номер потоку - різні потоки одночасно в різних пробах
+                const size_t probe = static_cast<size_t>((count + static_cast<uint64_t>(t)) % kProbes);
+                bool ok = true;
+                switch (probe) {
+                case 0: {
+                    ArgentumDevice device = collector.collect();
+                    ok = device.ram_mb == reference.ram_mb && device.cpu_cores == reference.cpu_cores &&
+                         device.cpu_model == reference.cpu_model;
+                    break;
+                }
+                case 1: {
+                    ArgentumDevice device = collector.collect(DeviceField::RAM | DeviceField::DiskIO | DeviceField::Network);
+                    ok = device.ram_mb == reference.ram_mb && !device.cpu_model.has_value() && device.disks.empty();
+                    break;
+                }
+                case 2:
+                    collector.collectInto(own, DeviceField::CPU | DeviceField::Power | DeviceField::Sensors);
+                    ok = own.cpu_model == reference.cpu_model && own.ram_mb == 0;
+                    break;
+                case 3:
+                    ok = collector.volumes(true).size() == reference.disks.size();
+                    break;
+                case 4:
+                    collector.invalidateCache("cmd:lsblk");
+                    ok = collector.diskType(rootDevice) == referenceDiskType;
+                    break;
+                default:
+                    // hwmon - перешук сенсорів паралельно з їх читанням у collectInto()
+                    collector.injectUevent(count % 2 ? blockEvent : hwmonEvent);
+                    break;
+                }
+                if (!ok)
+                    mismatches[probe].fetch_add(1, std::memory_order_relaxed);
+                ++count;
+            }
+            iterations[static_cast<size_t>(t)] = count;
+        });
+    }
+
+    std::this_thread::sleep_for(std::chrono::seconds(seconds));
+    stop.store(true);
+    for (std::thread& thread : threads)
+        thread.join();
+
+    uint64_t total = 0;
+    for (size_t t = 0; t < iterations.size(); ++t) {
+        total += iterations[t];
+        check(iterations[t] > 0, "stress: thread " + std::to_string(t) + " completed no calls");
+    }
+    static const char* const probeNames[kProbes] = {
+        "collect()", "collect(RAM|DiskIO|Network)", "collectInto(CPU|Power|Sensors)",
+        "volumes(true)", "diskType()", "injectUevent()"
+    };
+    for (size_t probe = 0; probe < kProbes; ++probe) {
+        const uint64_t count = mismatches[probe].load();
+        check(count == 0, std::string("stress: ") + probeNames[probe] + " differed from the reference " +
+              std::to_string(count) + " time(s)");
+    }
+
+    std::cout << "stress: " << threadCount << " threads, " << seconds << " s, " << total << " calls: "
+        << (g_failures == 0 ? "ok" : "failed") << std::endl;
+    return g_failures == 0 ? 0 : 1;
+}
+
+int runAllocCheck(int iterations)
+{
+    DeviceCollector collector;
+    CollectOptions sampling;
+    sampling.fields &= ~static_cast<uint32_t>(DeviceField::GPU);
+
+    // Прогрів: перелік томів, зони RAPL, ємність рядків та векторів
+    ArgentumDevice device;
+    for (int i = 0; i < 3; ++i)
+        collector.collectInto(device, sampling);
+
+    const uint64_t before = g_allocations.load();
+    for (int i = 0; i < iterations; ++i)
+        collector.collectInto(device, sampling);
+    const uint64_t allocations = g_allocations.load() - before;
+
+    check(allocations == 0, "alloc: steady-state collectInto() allocated " + std::to_string(allocations) + " time(s)");
+    std::cout << "alloc: " << iterations << " collectInto() call(s), " << allocations << " allocation(s)" << std::endl;
+    return g_failures == 0 ? 0 : 1;
+}
+
+#ifdef __linux__
+size_t countProcesses()
+{
+    size_t count = 0;
+    if (DIR* dir = opendir("/proc")) {
+        while (const dirent* entry = readdir(dir)) {
+            if (entry->d_name[0] >= '1' && entry->d_name[0] <= '9')
+                ++count;
+        }
+        closedir(dir);
+    }
+    return count;
+}
+#endif
+
+int runScan(size_t processes, int iterations)
+{
+#ifdef __linux__
+    // Дочірні процеси чекають, поки батько не закриє pipe
+    int pipeFds[2];
+    if (pipe(pipeFds) != 0) {
+        check(false, "scan: pipe() failed");
+        return 1;
+    }
+
+    std::vector<pid_t> children;
+    const size_t existing = countProcesses();
+    while (existing + children.size() < processes) {
+        pid_t pid = fork();
+        if (pid < 0)
+            break;
+        if (pid == 0) {
+            close(pipeFds[1]);
+            char byte;
+            while (read(pipeFds[0], &byte, 1) < 0) {}
+            _exit(0);
+        }
+        children.push_back(pid);
+    }
+    close(pipeFds[0]);
+    const size_t expected = existing + children.size();
+    check(expected >= processes, "scan: created only " + std::to_string(children.size()) + " child process(es)");
+
+    ProcessScanner scanner;
+    std::vector<double> durationsMs;
+    size_t seen = 0;
+    bool emptyTop = false;
+    scanner.scan(10, ProcessSortKey::CPU);      // Базова вибірка для CPU
+    for (int i = 0; i < iterations; ++i) {
+        emptyTop = emptyTop || scanner.scan(10, ProcessSortKey::CPU).empty();
+        durationsMs.push_back(scanner.lastScanDuration().count() / 1000.0);
+        seen = std::max(seen, scanner.lastProcessCount());
+    }
+
+    close(pipeFds[1]);
+    for (pid_t pid : children)
+        waitpid(pid, nullptr, 0);
+
+    // Чужі процеси можуть завершитися під час скану, дочірні - ні
+    check(seen >= children.size(), "scan: saw " + std::to_string(seen) + " of " +
+          std::to_string(expected) + " process(es)");
+    check(!emptyTop, "scan: empty top-N");
+
+    std::sort(durationsMs.begin(), durationsMs.end());
+    std::cout << "scan: " << seen << " processes, " << iterations << " scan(s): min "
+        << durationsMs.front() << " ms, p50 " << durationsMs[durationsMs.size() / 2] << " ms, max "
+        << durationsMs.back() << " ms" << std::endl;
+    return g_failures == 0 ? 0 : 1;
+#else
+    (void)processes;
+    (void)iterations;
+    std::cout << "scan: skipped (Linux only)" << std::endl;
+    return 0;
+#endif
+}
+
+// Значення, на яких ламаються кодувальники: межі int64, NaN з різним
+// навантаженням, ±0, нескінченності, денормалізовані
+const int64_t kEdgeIntegers[] = {
+    INT64_MIN, INT64_MAX, INT64_MIN + 1, INT64_MAX - 1, 0, -1, 1,
+};
+
+uint64_t bitsOf(double value)
+{
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+double fromBits(uint64_t bits)
+{
+    double value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+const uint64_t kEdgeDoubles[] = {
+    bitsOf(0.0), bitsOf(-0.0), bitsOf(1.0), bitsOf(-1.0),
+    bitsOf(std::numeric_limits<double>::quiet_NaN()),
+    0x7ff0000000000001ull,             // Сигнальний NaN
+    0xfff8dead0000beefull,             // Від'ємний NaN з навантаженням
+    bitsOf(std::numeric_limits<double>::infinity()),
+    bitsOf(-std::numeric_limits<double>::infinity()),
+    bitsOf(std::numeric_limits<double>::denorm_min()),
+    bitsOf(std::numeric_limits<double>::max()),
+    bitsOf(std::numeric_limits<double>::lowest()),
+};
+
+// Ряд із суміші меж, випадкових 64 бітів, повторів і дрібних кроків - як
+// лічильники та показники сенсорів, що змінюються на кілька одиниць
+std::vector<int64_t> randomIntegers(std::mt19937_64& random, size_t count)
+{
+    std::vector<int64_t> values;
+    int64_t previous = 0;
+    for (size_t i = 0; i < count; ++i) {
+        int64_t value;
+        switch (random() % 5) {
+        case 0: value = kEdgeIntegers[random() % (sizeof(kEdgeIntegers) / sizeof(kEdgeIntegers[0]))]; break;
+        case 1: value = static_cast<int64_t>(random()); break;
+        case 2: value = previous; break;
+        case 3: value = static_cast<int64_t>(static_cast<uint64_t>(previous) + random() % 16); break;
+        default: value = static_cast<int64_t>(static_cast<uint64_t>(previous) + (random() >> (random() % 64))); break;
+        }
+        values.push_back(value);
+        previous = value;
+    }
+    return values;
+}
+
+std::vector<uint64_t> randomDoubleBits(std::mt19937_64& random, size_t count)
+{
+    std::vector<uint64_t> values;
+    uint64_t previous = 0;
+    for (size_t i = 0; i < count; ++i) {
+        uint64_t value;
+        switch (random() % 5) {
+        case 0: value = kEdgeDoubles[random() % (sizeof(kEdgeDoubles) / sizeof(kEdgeDoubles[0]))]; break;
+        case 1: value = random(); break;
+        case 2: value = previous; break;
+        case 3: value = previous ^ (random() & 0xffff); break;          // Зміна в молодших бітах мантиси
+        default: value = bitsOf(30.0 + static_cast<double>(random() % 4000) / 100.0); break;   // Температура
+        }
+        values.push_back(value);
+        previous = value;
+    }
+    return values;
+}
+
+// Випадкові ряди через IntegerSeriesEncoder і DoubleSeriesEncoder: декодоване
+// має збігатися побітово, а декодер - зупинитися рівно після count значень
+int runCodec(int iterations, uint64_t seed)
+{
+    std::mt19937_64 random(seed);
+    const std::string seedNote = " (seed " + std::to_string(seed) + ")";
+    IntegerSeriesEncoder integers;
+    DoubleSeriesEncoder doubles;
+
+    for (int iteration = 0; iteration < iterations; ++iteration) {
+        const size_t count = 1 + random() % 300;
+        const std::string where = "iteration " + std::to_string(iteration) + seedNote;
+
+        const std::vector<int64_t> expectedIntegers = randomIntegers(random, count);
+        integers.clear();
+        for (int64_t value : expectedIntegers)
+            integers.append(value);
+        IntegerSeriesDecoder integerDecoder(integers.data(), integers.sizeBytes(), integers.count());
+        size_t mismatch = count;
+        for (size_t i = 0; i < count && mismatch == count; ++i) {
+            int64_t value = 0;
+            if (!integerDecoder.next(value) || value != expectedIntegers[i])
+                mismatch = i;
+        }
+        int64_t extra = 0;
+        check(mismatch == count, "integers: value " + std::to_string(mismatch) + " differs, " + where);
+        check(!integerDecoder.next(extra), "integers: decoder ran past count, " + where);
+
+        const std::vector<uint64_t> expectedDoubles = randomDoubleBits(random, count);
+        doubles.clear();
+        for (uint64_t bits : expectedDoubles)
+            doubles.append(fromBits(bits));
+        DoubleSeriesDecoder doubleDecoder(doubles.data(), doubles.sizeBytes(), doubles.count());
+        mismatch = count;
+        for (size_t i = 0; i < count && mismatch == count; ++i) {
+            double value = 0.0;
+            if (!doubleDecoder.next(value) || bitsOf(value) != expectedDoubles[i])
+                mismatch = i;
+        }
+        double extraDouble = 0.0;
+        check(mismatch == count, "doubles: value " + std::to_string(mismatch) + " differs, " + where);
+        check(!doubleDecoder.next(extraDouble), "doubles: decoder ran past count, " + where);
+    }
+
+    // Однакові chip/label з різних hwmon - окремі колонки, а не перший з двох
+    ArgentumDevice device;
+    for (const char* source : { "hwmon2", "hwmon3" }) {
+        SensorReading sensor;
+        sensor.chip = "nvme";
+        sensor.label = "Composite";
+        sensor.source = source;
+        sensor.value = 40.0;
+        device.sensors.push_back(sensor);
+    }
+    SampleSeries series;
+    series.append(1000, device);
+    size_t sensorColumns = 0;
+    for (const SampleSeries::Column& column : series.columns())
+        sensorColumns += column.name.compare(0, 7, "sensor:") == 0 && column.count() == 1;
+    check(sensorColumns == 2, "series: two nvme/Composite sensors share a column");
+
+    std::cout << "codec: " << iterations << " random series" << seedNote << ": "
+        << (g_failures == 0 ? "ok" : "failed") << std::endl;
+    return g_failures == 0 ? 0 : 1;
+}
+
+#ifdef __linux__
+// Файли segment-*.hwlog каталогу журналу за зростанням номера
+std::vector<std::string> segmentFiles(const std::string& directory)
+{
+    std::vector<std::string> files;
+    if (DIR* dir = opendir(directory.c_str())) {
+        while (const dirent* entry = readdir(dir)) {
+            if (strncmp(entry->d_name, "segment-", 8) == 0)
+                files.push_back(directory + "/" + entry->d_name);
+        }
+        closedir(dir);
+    }
+    std::sort(files.begin(), files.end());
+    return files;
+}
+
+// Записи журналу в порядку читання: мітки часу та чи збігся вміст з payload(мітка)
+std::vector<int64_t> readTimestamps(const SnapshotLog& log, bool& payloadsMatch,
+                                    const std::function<std::string(int64_t)>& payload)
+{
+    std::vector<int64_t> timestamps;
+    payloadsMatch = true;
+    log.read(INT64_MIN, INT64_MAX, [&](const SnapshotRecord& record) {
+        timestamps.push_back(record.timestamp_ms);
+        payloadsMatch = payloadsMatch && std::string(record.data, record.size) == payload(record.timestamp_ms);
+        return true;
+    });
+    return timestamps;
+}
+#endif
+
+// Журнал у тимчасовому каталозі: пошкоджений хвіст до high_water обнуляється
+// при open() і цілі записи лишаються, а ротація тримає не більше max_segments
+int runSnapshotLog()
+{
+#ifdef __linux__
+    char directoryTemplate[] = "/tmp/hwinfo-selftest-XXXXXX";
+    if (!mkdtemp(directoryTemplate)) {
+        check(false, "snapshotlog: mkdtemp failed");
+        return 1;
+    }
+    const std::string directory = directoryTemplate;
+
+    SnapshotLogOptions options;
+    options.segment_bytes = 64 * 1024;
+    options.max_segment_age = std::chrono::milliseconds(0);
+    options.index_interval = 4;
+    options.max_segments = 3;
+
+    // Вміст запису виводиться з мітки часу, тож кожен прочитаний перевіряється
+    auto payload = [](int64_t timestamp) {
+        const size_t size = timestamp >= 10000 ? 16 * 1024 : 100;
+        return std::string(size, static_cast<char>('a' + timestamp % 26));
+    };
+    auto appendRecord = [&payload](SnapshotLog& log, int64_t timestamp) {
+        const std::string data = payload(timestamp);
+        return log.appendRaw(timestamp, data.data(), data.size());
+    };
+
+    const int kSmallRecords = 20;
+    const int kLargeRecords = 12;
+    const uint64_t kSmallRecordBytes = (16 + 100 + 7) & ~uint64_t(7);   // Заголовок запису + дані, по 8 байт
+    {
+        SnapshotLog log(directory, options);
+        check(log.open(), "snapshotlog: open of an empty directory failed");
+        for (int i = 0; i < kSmallRecords; ++i)
+            check(appendRecord(log, 1000 + i), "snapshotlog: append " + std::to_string(i) + " failed");
+        check(!appendRecord(log, 999), "snapshotlog: append with a decreasing timestamp accepted");
+        check(log.flush(), "snapshotlog: flush failed");
+    }
+
+    // Перерваний запис: сміття після останнього цілого запису, high_water
+    // у заголовку сегмента (зміщення 32) вже просунуто за нього
+    const std::vector<std::string> files = segmentFiles(directory);
+    check(files.size() == 1, "snapshotlog: expected one segment, got " + std::to_string(files.size()));
+    const uint64_t tail = 64 + kSmallRecords * kSmallRecordBytes;
+    const uint64_t kGarbageBytes = 256;
+    if (!files.empty()) {
+        int fd = open(files.front().c_str(), O_RDWR | O_CLOEXEC);
+        const std::string garbage(kGarbageBytes, '\xAB');
+        const uint64_t highWater = tail + kGarbageBytes;
+        check(fd >= 0 &&
+              pwrite(fd, garbage.data(), garbage.size(), static_cast<off_t>(tail)) == static_cast<ssize_t>(garbage.size()) &&
+              pwrite(fd, &highWater, sizeof(highWater), 32) == static_cast<ssize_t>(sizeof(highWater)),
+              "snapshotlog: could not corrupt the segment tail");
+        if (fd >= 0)
+            close(fd);
+    }
+
+    {
+        SnapshotLog log(directory, options);
+        check(log.open(), "snapshotlog: reopen after a torn tail failed");
+        SnapshotLog::Stats stats = log.stats();
+        check(stats.recovered_bytes == kGarbageBytes,
+              "snapshotlog: recovered " + std::to_string(stats.recovered_bytes) + " bytes, expected " +
+              std::to_string(kGarbageBytes));
+        bool payloadsMatch = false;
+        std::vector<int64_t> timestamps = readTimestamps(log, payloadsMatch, payload);
+        check(timestamps.size() == static_cast<size_t>(kSmallRecords),
+              "snapshotlog: " + std::to_string(timestamps.size()) + " records readable after recovery, expected " +
+              std::to_string(kSmallRecords));
+        check(payloadsMatch, "snapshotlog: record payload changed by recovery");
+
+        // Сміття обнулене в самому файлі, а не лише пропущене сканом
+        std::string torn(kGarbageBytes, '\x01');
+        int fd = files.empty() ? -1 : open(files.front().c_str(), O_RDONLY | O_CLOEXEC);
+        const bool readBack = fd >= 0 &&
+            pread(fd, &torn[0], torn.size(), static_cast<off_t>(tail)) == static_cast<ssize_t>(torn.size());
+        if (fd >= 0)
+            close(fd);
+        check(readBack && torn == std::string(kGarbageBytes, '\0'), "snapshotlog: torn tail not zeroed on disk");
+
+        // Після відновлення запис продовжується з кінця останнього цілого запису
+        check(appendRecord(log, 2000), "snapshotlog: append after recovery failed");
+        timestamps = readTimestamps(log, payloadsMatch, payload);
+        check(timestamps.size() == static_cast<size_t>(kSmallRecords + 1) && timestamps.back() == 2000 && payloadsMatch,
+              "snapshotlog: record appended after recovery not readable");
+
+        // Записи по 16 КБ: три на сегмент, тож 12 записів - кілька ротацій
+        for (int i = 0; i < kLargeRecords; ++i)
+            check(appendRecord(log, 10000 + i), "snapshotlog: large append " + std::to_string(i) + " failed");
+        check(log.flush(), "snapshotlog: flush after rotation failed");
+
+        stats = log.stats();
+        check(stats.segments == options.max_segments,
+              "snapshotlog: " + std::to_string(stats.segments) + " segments after rotation, expected " +
+              std::to_string(options.max_segments));
+        check(segmentFiles(directory).size() == options.max_segments,
+              "snapshotlog: evicted segment files left in the directory");
+        timestamps = readTimestamps(log, payloadsMatch, payload);
+        check(!timestamps.empty() && timestamps.front() >= 10000 && timestamps.back() == 10000 + kLargeRecords - 1,
+              "snapshotlog: oldest segments not evicted or newest records missing");
+        check(std::is_sorted(timestamps.begin(), timestamps.end()) && payloadsMatch,
+              "snapshotlog: records out of order or corrupted after rotation");
+        check(timestamps.size() == stats.records, "snapshotlog: read() and stats() disagree on the record count");
+    }
+
+    {
+        // Чисто закритий журнал відкривається без відновлення
+        SnapshotLog log(directory, options);
+        check(log.open(), "snapshotlog: reopen after rotation failed");
+        const SnapshotLog::Stats stats = log.stats();
+        check(stats.recovered_bytes == 0, "snapshotlog: clean reopen recovered bytes");
+        check(stats.segments == options.max_segments && stats.last_timestamp_ms == 10000 + kLargeRecords - 1,
+              "snapshotlog: rotated segments not reopened");
+    }
+
+    for (const std::string& file : segmentFiles(directory))
+        unlink(file.c_str());
+    rmdir(directory.c_str());
+
+    std::cout << "snapshotlog: " << (g_failures == 0 ? "ok" : "failed") << std::endl;
+    return g_failures == 0 ? 0 : 1;
+#else
+    std::cout << "snapshotlog: skipped (Linux only)" << std::endl;
+    return 0;
+#endif
+}
+
+// Еталон для FleetTable: відсортовані вибрані значення і лінійна інтерполяція
+double naiveQuantile(std::vector<double> sorted, double q)
+{
+    if (sorted.empty())
+        return std::numeric_limits<double>::quiet_NaN();
+    std::sort(sorted.begin(), sorted.end());
+    const double rank = q * static_cast<double>(sorted.size() - 1);
+    const size_t k = static_cast<size_t>(rank);
+    if (k + 1 >= sorted.size())
+        return sorted[k];
+    return sorted[k] + (rank - static_cast<double>(k)) * (sorted[k + 1] - sorted[k]);
+}
+
+bool sameQuantile(double actual, double expected)
+{
+    if (std::isnan(expected))
+        return std::isnan(actual);
+    return std::fabs(actual - expected) <= 1e-9 * std::max(1.0, std::fabs(expected));
+}
+
+// quantiles() і groupBy() на випадкових колонках з NaN проти наївного сортування;
+// маски бувають коротші й довші за колонку - рядки поза маскою не вибрані
+int runFleet(int iterations, uint64_t seed)
+{
+    std::mt19937_64 random(seed);
+    const std::string seedNote = " (seed " + std::to_string(seed) + ")";
+    const std::vector<double> q = { 0.0, 0.1, 0.25, 0.5, 0.9, 0.99, 1.0 };
+
+    for (int iteration = 0; iteration < iterations; ++iteration) {
+        const std::string where = "iteration " + std::to_string(iteration) + seedNote;
+        const size_t rows = random() % 200;
+        const uint32_t keyCount = 1 + static_cast<uint32_t>(random() % 8);
+
+        std::vector<double> values(rows);
+        std::vector<uint32_t> keys(rows);
+        for (size_t i = 0; i < rows; ++i) {
+            values[i] = random() % 10 == 0 ? std::numeric_limits<double>::quiet_NaN()
+                                           : static_cast<double>(random() % 1000) / 8.0;
+            keys[i] = static_cast<uint32_t>(random() % keyCount);
+        }
+
+        const size_t maskRows = rows + random() % 20 - std::min<size_t>(rows, 10);
+        FleetTable::Mask mask(maskRows);
+        for (uint8_t& selected : mask)
+            selected = static_cast<uint8_t>(random() % 3 != 0);
+
+        const FleetTable::Mask* const masks[] = { nullptr, &mask };
+        for (const FleetTable::Mask* maskPtr : masks) {
+            const std::string label = (maskPtr ? "masked " : "unmasked ") + where;
+            const size_t selectable = maskPtr ? std::min(rows, maskPtr->size()) : rows;
+
+            std::vector<double> selected;
+            std::vector<std::vector<double>> byKey(keyCount);
+            for (size_t i = 0; i < selectable; ++i) {
+                if ((maskPtr && !(*maskPtr)[i]) || std::isnan(values[i]))
+                    continue;
+                selected.push_back(values[i]);
+                byKey[keys[i]].push_back(values[i]);
+            }
+
+            const std::vector<double> actual = FleetTable::quantiles(values, maskPtr, q);
+            bool quantilesMatch = actual.size() == q.size();
+            for (size_t k = 0; quantilesMatch && k < q.size(); ++k)
+                quantilesMatch = sameQuantile(actual[k], naiveQuantile(selected, q[k]));
+            check(quantilesMatch, "fleet: quantiles differ from a sort, " + label);
+
+            const std::vector<FleetTable::GroupStats> groups = FleetTable::groupBy(keys, values, maskPtr, q);
+            size_t expectedGroups = 0;
+            bool groupsMatch = true;
+            for (uint32_t key = 0; key < keyCount; ++key) {
+                const std::vector<double>& expected = byKey[key];
+                if (expected.empty())
+                    continue;
+                const auto group = std::find_if(groups.begin(), groups.end(),
+                                                [key](const FleetTable::GroupStats& g) { return g.key == key; });
+                ++expectedGroups;
+                if (group == groups.end() || group->count != expected.size() ||
+                    group->min != *std::min_element(expected.begin(), expected.end()) ||
+                    group->max != *std::max_element(expected.begin(), expected.end()) ||
+                    !sameQuantile(group->sum, std::accumulate(expected.begin(), expected.end(), 0.0)) ||
+                    group->quantiles.size() != q.size()) {
+                    groupsMatch = false;
+                    continue;
+                }
+                for (size_t k = 0; k < q.size(); ++k)
+                    groupsMatch = groupsMatch && sameQuantile(group->quantiles[k], naiveQuantile(expected, q[k]));
+            }
+            check(groupsMatch && groups.size() == expectedGroups, "fleet: groupBy differs from a sort, " + label);
+        }
+    }
+
+    std::cout << "fleet: " << iterations << " random tables" << seedNote << ": "
+        << (g_failures == 0 ? "ok" : "failed") << std::endl;
+    return g_failures == 0 ? 0 : 1;
+}
+
+DiskInfo diskSample(const std::string& mountPoint, uint64_t totalMb, uint64_t freeMb)
+{
+    DiskInfo disk{};
+    disk.mount_point = mountPoint;
+    disk.total_mb = totalMb;
+    disk.free_mb = freeMb;
+    disk.used_mb = totalMb - freeMb;
+    disk.usage_percent = 100.0 * static_cast<double>(disk.used_mb) / static_cast<double>(totalMb);
+    disk.free_percent = 100.0 - disk.usage_percent;
+    return disk;
+}
+
+size_t countAlerts(const std::vector<DiskFillAlert>& alerts, const std::string& rule, bool firing)
+{
+    return static_cast<size_t>(std::count_if(alerts.begin(), alerts.end(), [&](const DiskFillAlert& alert) {
+        return alert.rule == rule && alert.firing == firing;
+    }));
+}
+
+// DiskFillForecaster на синтетичних вибірках: ETA лінійного заповнення,
+// гістерезис правила та зняття сповіщень зниклої точки монтування
+int runForecast()
+{
+    const int64_t kStepMs = 60 * 1000;
+
+    // Рівно 100 МБ за хвилину з 500000 МБ: нахил -6000 МБ/год, ETA - free / нахил
+    {
+        DiskFillForecaster forecaster;
+        forecaster.addRule(DiskFillRule::timeToFullBelow("disk-4d", std::chrono::hours(96), std::chrono::hours(120)));
+        std::vector<DiskFillAlert> alerts;
+        uint64_t freeMb = 500000;
+        for (int i = 0; i < 30; ++i, freeMb -= 100)
+            forecaster.update(i * kStepMs, { diskSample("/data", 1000000, freeMb) }, alerts);
+
+        const std::optional<DiskFillForecast> forecast = forecaster.forecast("/data");
+        const double expectedSeconds = static_cast<double>(freeMb + 100) / (100.0 / 60.0);
+        check(forecast.has_value() && forecast->free_mb_per_hour.has_value() &&
+              std::fabs(*forecast->free_mb_per_hour + 6000.0) <= 6000.0 * 0.01,
+              "forecast: linear fill trend is not -6000 MB/h");
+        check(forecast.has_value() && forecast->time_to_full.has_value() &&
+              std::fabs(static_cast<double>(forecast->time_to_full->count()) - expectedSeconds) <= expectedSeconds * 0.01,
+              "forecast: time to full off by more than 1% (expected " +
+              std::to_string(static_cast<int64_t>(expectedSeconds)) + " s)");
+        // ~83 год до заповнення - нижче 96 год: одне спрацювання, без повторів
+        check(countAlerts(alerts, "disk-4d", true) == 1 && countAlerts(alerts, "disk-4d", false) == 0,
+              "forecast: linear fill did not fire disk-4d exactly once");
+    }
+
+    // Використання коливається між clear (85%) і fire (90%) та через fire:
+    // одне спрацювання, зняття - лише після падіння нижче clear
+    {
+        DiskFillForecaster forecaster;
+        forecaster.addRule(DiskFillRule::usageAbove("disk-90pct", 90.0, 85.0));
+        std::vector<DiskFillAlert> alerts;
+        const uint64_t usedPercent[] = { 80, 91, 86, 92, 87, 90, 86, 95, 85, 89, 91, 86 };
+        int64_t timestamp = 0;
+        for (uint64_t used : usedPercent) {
+            forecaster.update(timestamp, { diskSample("/home", 1000, 1000 - used * 10) }, alerts);
+            timestamp += kStepMs;
+        }
+        check(countAlerts(alerts, "disk-90pct", true) == 1 && countAlerts(alerts, "disk-90pct", false) == 0,
+              "forecast: oscillation between clear and fire produced " + std::to_string(alerts.size()) + " alert(s)");
+        check(forecaster.isFiring("disk-90pct", "/home"), "forecast: disk-90pct not firing while above clear");
+
+        alerts.clear();
+        forecaster.update(timestamp, { diskSample("/home", 1000, 1000 - 840) }, alerts);
+        check(countAlerts(alerts, "disk-90pct", false) == 1 && !forecaster.isFiring("disk-90pct", "/home"),
+              "forecast: drop below clear did not clear disk-90pct");
+    }
+
+    // Точка монтування зникла: сповіщення живе до forget_after і знімається після
+    {
+        DiskFillOptions options;
+        options.forget_after = std::chrono::minutes(10);
+        DiskFillForecaster forecaster(options);
+        forecaster.addRule(DiskFillRule::usageAbove("disk-90pct", 90.0, 85.0));
+        std::vector<DiskFillAlert> alerts;
+        forecaster.update(0, { diskSample("/mnt/usb", 1000, 50), diskSample("/", 1000, 500) }, alerts);
+        check(forecaster.isFiring("disk-90pct", "/mnt/usb"), "forecast: 95% usage did not fire");
+
+        alerts.clear();
+        forecaster.update(10 * kStepMs, { diskSample("/", 1000, 500) }, alerts);
+        check(alerts.empty() && forecaster.isFiring("disk-90pct", "/mnt/usb"),
+              "forecast: alert cleared before forget_after");
+
+        forecaster.update(11 * kStepMs, { diskSample("/", 1000, 500) }, alerts);
+        check(alerts.size() == 1 && !alerts.front().firing && alerts.front().mount_point == "/mnt/usb",
+              "forecast: alert of a vanished mount not cleared after forget_after");
+        check(!forecaster.isFiring("disk-90pct", "/mnt/usb") && !forecaster.forecast("/mnt/usb").has_value(),
+              "forecast: vanished mount still tracked after forget_after");
+        check(forecaster.forecast("/").has_value(), "forecast: mount still sampled was forgotten");
+    }
+
+    std::cout << "forecast: " << (g_failures == 0 ? "ok" : "failed") << std::endl;
+    return g_failures == 0 ? 0 : 1;
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    const char* mode = argc > 1 ? argv[1] : "";
+    if (strcmp(mode, "uevents") == 0)
+        return runUevents();
+    if (strcmp(mode, "cache") == 0)
+        return runCacheCheck();
+    if (strcmp(mode, "codec") == 0)
+        return runCodec(argc > 2 ? std::max(1, atoi(argv[2])) : 2000,
+                        argc > 3 ? strtoull(argv[3], nullptr, 10) : 20240601);
+    if (strcmp(mode, "forecast") == 0)
+        return runForecast();
+    if (strcmp(mode, "fleet") == 0)
+        return runFleet(argc > 2 ? std::max(1, atoi(argv[2])) : 500,
+                        argc > 3 ? strtoull(argv[3], nullptr, 10) : 20240601);
+    if (strcmp(mode, "snapshotlog") == 0)
+        return runSnapshotLog();
+    if (strcmp(mode, "stress") == 0)
+        return runStress(argc > 2 ? std::max(1, atoi(argv[2])) : 8, argc > 3 ? std::max(1, atoi(argv[3])) : 3);
+    if (strcmp(mode, "alloc") == 0)
+        return runAllocCheck(argc > 2 ? std::max(1, atoi(argv[2])) : 1000);
+
+    if (strcmp(mode, "scan") == 0)
+        return runScan(argc > 2 ? static_cast<size_t>(std::max(1, atoi(argv[2]))) : 20000,
+                       argc > 3 ? std::max(1, atoi(argv[3])) : 20);
+
+    std::cerr << "usage: hwinfo_selftest uevents | cache | codec [iterations] [seed] | snapshotlog"
+        " | fleet [iterations] [seed] | forecast | stress [threads] [seconds] | alloc [iterations]"
+        " | scan [processes] [iterations]" << std::endl;
+    return 2;
+}
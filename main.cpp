@@ -2,12 +2,25 @@
 #include <QDebug>
 #include <iostream>
 #include <iomanip>
+#include <cstring>
+#include <string>
 #include "HardwareInfoProvider.h"
+#include "ProcessScanner.h"
+#include "Tracer.h"
 
 int main(int argc, char* argv[])
 {
     QCoreApplication app(argc, argv);
 
+    // --trace file.json: Chrome trace_event збору (Perfetto, about://tracing)
+    std::string tracePath;
+    for (int i = 1; i + 1 < argc; ++i) {
+        if (strcmp(argv[i], "--trace") == 0) {
+            tracePath = argv[i + 1];
+            Tracer::setEnabled(true);
+        }
+    }
+
     std::cout << "\n";
     std::cout << "=====================================" << std::endl;
     std::cout << "  Hardware Info Provider v4.2" << std::endl;
@@ -20,13 +33,30 @@ int main(int argc, char* argv[])
 
     // Отримуємо структуру ArgentumDevice
     std::cout << "Collecting device information..." << std::endl;
-    ArgentumDevice device = hw.getDeviceInfo();
+    CollectionStats stats;
+    ArgentumDevice device = hw.getDeviceInfo(stats);
     std::cout << "Done!" << std::endl;
     std::cout << "\n";
 
     // Виводимо структуру в консоль
     HardwareInfoProvider::printDeviceInfo(device);
 
+    // Скільки коштувала кожна проба
+    HardwareInfoProvider::printCollectionStats(stats);
+
+    SourceCache::Stats cacheStats = hw.getCacheStats();
+    std::cout << "Source cache: " << cacheStats.hits << " hit(s), " << cacheStats.misses << " miss(es), "
+        << cacheStats.coalesced << " coalesced, " << cacheStats.entries << " entr(ies)" << std::endl;
+
+    if (!tracePath.empty()) {
+        if (Tracer::writeChromeTrace(tracePath)) {
+            std::cout << "Trace: " << Tracer::eventCount() << " events -> " << tracePath << std::endl;
+        }
+        else {
+            std::cerr << "Cannot write trace " << tracePath << std::endl;
+        }
+    }
+
     std::cout << "\n";
     std::cout << "=====================================" << std::endl;
     std::cout << "  Accessing Structure Fields Demo" << std::endl;
@@ -126,6 +156,21 @@ int main(int argc, char* argv[])
         }
     }
 
+    // Топ процесів за пам'яттю
+    ProcessScanner scanner;
+    std::vector<ProcessInfo> topProcesses = scanner.scan(5, ProcessSortKey::RSS);
+    if (!topProcesses.empty()) {
+        std::cout << "--- Top Processes (RSS) ---" << std::endl;
+        std::cout << "\n";
+
+        for (const ProcessInfo& process : topProcesses) {
+            std::cout << std::setw(8) << process.pid << "  "
+                << std::setw(10) << HardwareInfoProvider::formatBytesMB(process.rss_kb / 1024)
+                << "  " << process.name << std::endl;
+        }
+        std::cout << std::endl;
+    }
+
     // JSON-подібний вивід
     std::cout << "=====================================" << std::endl;
     std::cout << "  JSON-like Structure Example" << std::endl;